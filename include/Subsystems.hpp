@@ -8,4 +8,9 @@ void chomperTelecontrol();
 void setIntake(int speed);
 void wingControl(bool state);
 void BwingControl(bool state);
-void matchLoad(bool matchLoading, bool skills);
\ No newline at end of file
+void matchLoad(bool matchLoading);
+
+extern pros::Motor catapult;
+extern pros::Motor Intake1;
+extern pros::Motor Intake2;
+extern pros::Motor_Group Intake;
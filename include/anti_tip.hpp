@@ -0,0 +1,109 @@
+#pragma once
+
+#include "EZ-Template/drive/drive.hpp"
+
+/**
+ * Keeps the robot from tipping over on the bar or on hard stops.
+ *
+ * A task watches the IMU's pitch and roll.  When the robot is pitched past a
+ * threshold, or pitching fast, limit() only lets the forward command change
+ * slowly in the direction that's tipping it, and when it's rolled it slows
+ * down changes in turning.  Going the other way is never limited, so the
+ * driver can always pull the robot back down.  While tipping the drive's
+ * current is also cut, which slows EZ-Template's own motions too.
+ *
+ * limit() only uses what the task already read, so it's cheap to call every tick.
+ */
+class AntiTip {
+ public:
+  /**
+   * Creates anti-tip.
+   *
+   * \param drive
+   *        Drive with the IMU.
+   */
+  AntiTip(Drive &drive);
+
+  /**
+   * Zeroes pitch and roll and starts the task, reccomended to run in initialize() with the robot flat.
+   */
+  void initialize();
+
+  /**
+   * Limits a drive command.  Call with every command sent to the drive.
+   *
+   * \param left
+   *        -127 to 127, changed in place
+   * \param right
+   *        -127 to 127, changed in place
+   */
+  void limit(double &left, double &right);
+
+  /**
+   * Returns true while the robot is pitched or rolled.
+   */
+  bool is_tipping();
+
+  /**
+   * Returns how many times the robot has started tipping.
+   */
+  int get_tip_count();
+
+  /**
+   * Sets what counts as tipping.
+   *
+   * \param pitch
+   *        degrees of pitch
+   * \param pitch_rate
+   *        degrees per second of pitch
+   * \param roll
+   *        degrees of roll
+   */
+  void set_thresholds(double pitch, double pitch_rate, double roll);
+
+  /**
+   * Sets how fast the command can change toward tipping.
+   *
+   * \param per_tick
+   *        change every ez::util::DELAY_TIME, out of 127
+   */
+  void set_max_change(double per_tick);
+
+  /**
+   * Flips pitch if the IMU reads nose up as negative.  True flips.
+   *
+   * \param toggle
+   *        bool input
+   */
+  void set_pitch_reversed(bool toggle);
+
+ private:
+  Drive &drive;
+
+  double pitch_threshold = 8;
+  double pitch_rate_threshold = 60;
+  double roll_threshold = 8;
+  double max_change = 4;
+  bool pitch_reversed = false;
+
+  double pitch_zero = 0;
+  double roll_zero = 0;
+  double last_pitch = 0;
+
+  // 1 nose up, -1 nose down, 0 flat
+  int pitch_direction = 0;
+  bool rolled = false;
+  int tip_count = 0;
+
+  double last_forward = 0;
+  double last_turn = 0;
+  int last_time = 0;
+
+  void update();
+  void tip_task();
+};
+
+/**
+ * Anti-tip for the chassis.
+ */
+extern AntiTip antiTip;
@@ -0,0 +1,98 @@
+#pragma once
+
+#include "api.h"
+
+/**
+ * Scales motor commands so they act the same as the battery drains.
+ *
+ * A motor given 12000mV on a full battery and on a tired one doesn't spin the
+ * same, so the same auton drives differently at 12.8V and 11.9V.  A filtered
+ * battery reading gives a gain of nominal voltage over battery voltage, and
+ * commands are multiplied by it before they're sent.  Commands can't go past
+ * full power, so a battery below nominal only helps commands below full.
+ *
+ * Only commands sent through compensate() are scaled: the custom motions,
+ * driver control, the intake and the catapult.  EZ-Template's own
+ * set_drive_pid(), set_turn_pid() and set_swing_pid() write the motors from
+ * its task and can't be compensated.
+ */
+class VoltageCompensator {
+ public:
+  /**
+   * Creates a voltage compensator.
+   *
+   * \param nominal
+   *        mV that commands are tuned at
+   */
+  VoltageCompensator(int nominal = 12800);
+
+  /**
+   * Starts the filtering task, reccomended to run in initialize().
+   */
+  void initialize();
+
+  /**
+   * Scales a command by the gain.
+   *
+   * \param command
+   *        any command, like -127 to 127 or -12000 to 12000
+   * \param max
+   *        full power in the same units as command
+   */
+  double compensate(double command, double max);
+
+  /**
+   * Returns the filtered battery voltage in mV.
+   */
+  double get_voltage();
+
+  /**
+   * Returns nominal voltage over battery voltage.
+   */
+  double get_gain();
+
+  /**
+   * Compensation on or off.  True enables, false disables.
+   *
+   * \param toggle
+   *        bool input
+   */
+  void set_enabled(bool toggle);
+
+  /**
+   * Sets the mV that commands are tuned at.
+   *
+   * \param mV
+   *        nominal voltage
+   */
+  void set_nominal(int mV);
+
+  /**
+   * Prints battery voltage and gain, now and lowest/highest seen, to the terminal.
+   */
+  void print_report();
+
+ private:
+  int nominal;
+  bool enabled = true;
+  double voltage = 0;
+  double lowest = 0;
+  double highest_gain = 1;
+
+  void battery_task();
+};
+
+/**
+ * Drives the chassis like set_tank(), through anti-tip and with the battery compensation applied.  The custom motions send everything through here.
+ *
+ * \param left
+ *        -127 to 127
+ * \param right
+ *        -127 to 127
+ */
+void compensated_tank(double left, double right);
+
+/**
+ * Voltage compensation for the motors we command ourselves.
+ */
+extern VoltageCompensator voltageComp;
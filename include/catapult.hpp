@@ -0,0 +1,199 @@
+#pragma once
+
+#include "api.h"
+
+/**
+ * Fires the catapult/slapper by encoder position instead of just spinning it.
+ *
+ * Every cycle_degrees of motor travel is one shot.  The encoder is zeroed in
+ * initialize() with the catapult just fired, so each multiple of
+ * cycle_degrees is a release.  fire(n) counts releases, then parks the
+ * catapult loaded at reload_position so the next shot is instant.  Each
+ * shot's cycle time is recorded so match loading can be timed.
+ *
+ * With a load sensor, match_load(n) waits loaded at the reload position and
+ * only fires once the sensor sees a triball sitting on the catapult, instead
+ * of spinning the motor the whole time.  If the sensor isn't reporting it
+ * fires like fire() instead.
+ */
+class CatapultController {
+ public:
+  /**
+   * Creates a catapult controller.
+   *
+   * \param motor
+   *        catapult motor
+   * \param cycle_degrees
+   *        motor degrees from one release to the next
+   * \param reload_position
+   *        motor degrees after a release where the catapult is loaded
+   */
+  CatapultController(pros::Motor &motor, double cycle_degrees, double reload_position);
+
+  /**
+   * Zeroes the encoder and starts the catapult task, reccomended to run in initialize() with the catapult just fired.
+   */
+  void initialize();
+
+  /**
+   * Fires a number of shots, then stops loaded.
+   *
+   * \param shots
+   *        shots to fire, 0 fires until stop() is called
+   */
+  void fire(int shots = 1);
+
+  /**
+   * Fires a number of shots, each one only once the load sensor sees a triball.  Without a working load sensor this is fire().
+   *
+   * \param shots
+   *        shots to fire, 0 fires until stop() is called
+   */
+  void match_load(int shots);
+
+  /**
+   * Adds a distance sensor that sees a triball loaded on the catapult.
+   *
+   * \param port
+   *        Port the distance sensor is plugged into.
+   * \param load_distance
+   *        readings closer than this, in mm, are a loaded triball
+   * \param load_delay
+   *        ms the triball has to be seen before firing, so it settles on the catapult
+   */
+  void set_load_sensor(int port, int load_distance = 60, int load_delay = 40);
+
+  /**
+   * Returns true if the load sensor sees a triball.
+   */
+  bool triball_loaded();
+
+  /**
+   * Stops at the next reload position.
+   */
+  void stop();
+
+  /**
+   * Returns true while the catapult is firing or moving to reload.
+   */
+  bool is_running();
+
+  /**
+   * Blocks until the catapult is stopped and loaded.  Returns false if it timed out.
+   *
+   * \param timeout
+   *        max time to wait in ms
+   */
+  bool wait_until_done(int timeout = 5000);
+
+  /**
+   * Sets where the catapult stops loaded.
+   *
+   * \param degrees
+   *        motor degrees after a release
+   */
+  void set_reload_position(double degrees);
+
+  /**
+   * Rests loaded between shots when firing continuously, so the motor spends less time under load.
+   *
+   * \param duty
+   *        0 to 1, fraction of the time spent firing, 1 never rests
+   */
+  void set_duty_cycle(double duty);
+
+  /**
+   * Returns shots fired since initialize().
+   */
+  int get_shot_count();
+
+  /**
+   * Returns ms between the last two shots.
+   */
+  int get_last_cycle_time();
+
+  /**
+   * Returns average ms between shots.
+   */
+  double get_average_cycle_time();
+
+  /**
+   * Returns shots per minute from the average cycle time.
+   */
+  double get_shots_per_minute();
+
+  /**
+   * Clears shot counts and cycle times.
+   */
+  void reset_stats();
+
+  /**
+   * Prints shot count, cycle times and a histogram of cycle times to the terminal.
+   */
+  void print_report();
+
+ private:
+  pros::Motor &motor;
+  double cycle_degrees;
+  double reload_position;
+  bool running = false;
+  bool reloading = false;
+  int target_shots = 0;
+  int shots_this_run = 0;
+  double reload_target = 0;
+  int last_cycle = 0;
+  bool stop_requested = false;
+  double duty = 1;
+  int rest_timer = 0;
+  int rest_time = 0;
+
+  // Match loading with a load sensor
+  pros::Distance *load_sensor = nullptr;
+  int load_distance = 60;
+  int load_delay = 40;
+  int load_timer = 0;
+  int sensor_error_timer = 0;
+  bool synced = false;
+  bool firing = false;
+  int fire_cycle = 0;
+
+  int shot_count = 0;
+  int last_shot_time = 0;
+  int last_cycle_time = 0;
+  int cycle_time_sum = 0;
+  int cycle_count = 0;
+
+  /**
+   * Cycle times in 100ms buckets, the last bucket is everything slower.
+   */
+  static const int HISTOGRAM_BUCKETS = 15;
+
+  /**
+   * mV the catapult always fired at.  Past 12000 the motor runs flat out, so a fresh battery still fires at full power.
+   */
+  static const int FIRE_VOLTAGE = 12500;
+  int histogram[HISTOGRAM_BUCKETS] = {0};
+
+  /**
+   * Returns true if there's a load sensor and it's reporting.
+   */
+  bool load_sensor_connected();
+
+  /**
+   * Which cycle the encoder is in, increases by one every release.
+   */
+  int get_cycle();
+
+  /**
+   * Records a release.
+   */
+  void record_shot();
+
+  void update();
+  void catapult_task();
+};
+
+/**
+ * Catapult controller for the catapult motor.
+ */
+extern CatapultController catapultController;
@@ -0,0 +1,114 @@
+#pragma once
+
+#include <functional>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "api.h"
+
+/**
+ * Splits the brain's current budget between the drive, intake and catapult.
+ *
+ * Every motor defaults to 2500mA, and nine of them can ask for more than the
+ * brain gives out, so the firmware throttles whichever it likes.  Here each
+ * group gets its minimum, then what's left goes to active groups by priority,
+ * with the focused group first no matter its priority.  push() focuses the
+ * drive while it runs.  Limits are recalculated every 50ms and written with
+ * set_current_limit.
+ */
+class CurrentArbiter {
+ public:
+  /**
+   * Creates a current arbiter.
+   *
+   * \param budget
+   *        mA shared by every group
+   */
+  CurrentArbiter(int budget = 20000);
+
+  /**
+   * Adds a group of motors.
+   *
+   * \param name
+   *        group name
+   * \param motors
+   *        number of motors in the group
+   * \param min_mA
+   *        mA each motor always gets
+   * \param priority
+   *        higher gets current first
+   * \param limit
+   *        called with the mA limit for each motor
+   * \param active
+   *        returns true while the group needs current, idle groups only get min_mA.  nullptr is always active
+   */
+  void add(std::string name, int motors, int min_mA, int priority, std::function<void(int)> limit, std::function<bool()> active = nullptr);
+
+  /**
+   * Starts the arbiter task, reccomended to run in initialize().
+   */
+  void initialize();
+
+  /**
+   * Gives a group current before every other group.
+   *
+   * \param name
+   *        group name, "" for no focus
+   */
+  void set_focus(std::string name);
+
+  /**
+   * Scales the most a group can get, like for overheating.  Scales from different reasons multiply.
+   *
+   * \param name
+   *        group name
+   * \param scale
+   *        0 to 1, fraction of 2500mA per motor
+   * \param reason
+   *        what's asking, so overheating and wheel slip don't overwrite each other
+   */
+  void set_scale(std::string name, double scale, std::string reason = "");
+
+  /**
+   * Returns the mA limit each motor in a group has now.
+   *
+   * \param name
+   *        group name
+   */
+  int get_limit(std::string name);
+
+  /**
+   * Prints each group's limit and whether it's active to the terminal.
+   */
+  void print_report();
+
+ private:
+  struct group {
+    std::string name;
+    int motors;
+    int min_mA;
+    int priority;
+    std::function<void(int)> limit;
+    std::function<bool()> active;
+    std::map<std::string, double> scales;
+    double scale = 1;
+    int allocated = -1;
+  };
+
+  std::vector<group> groups;
+  int budget;
+  std::string focus = "";
+  pros::Mutex mutex;
+
+  // Most a V5 motor will draw
+  const int MAX_MA = 2500;
+
+  group *find(std::string name);
+  void update();
+};
+
+/**
+ * Current arbiter for every motor on the robot.
+ */
+extern CurrentArbiter currentArbiter;
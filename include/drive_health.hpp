@@ -0,0 +1,123 @@
+#pragma once
+
+#include "EZ-Template/drive/drive.hpp"
+
+/**
+ * Enum for drive motor health.
+ */
+enum motor_health { MOTOR_OK = 0,
+                    MOTOR_DISCONNECTED = 1,
+                    MOTOR_FAULTED = 2,
+                    MOTOR_GLITCHING = 3 };
+
+/**
+ * Reads every drive motor's encoder instead of just the sensored one.
+ *
+ * Every tick the change in position of each healthy motor on a side is
+ * compared against the others, changes that disagree with the side are
+ * rejected, and the rest are averaged into one position per side.  Motors
+ * are flagged from a missing reading, get_faults() and get_flags(), and a
+ * motor that keeps disagreeing is flagged as glitching.  When the sensored
+ * motor (the first one in each side's vector) is flagged, a healthy motor on
+ * the same side takes its place in the Drive within the tick, so
+ * left_sensor()/right_sensor() keep working, in the middle of a motion too.
+ * A pros::Motor only holds its port, so the swap rebuilds the two motors in
+ * place under the monitoring mutex and a reader in another task sees either
+ * the old port or the new one.
+ *
+ * EZ-Template only tares the sensored motor, call tare() after
+ * reset_drive_sensor() so every motor reads the same if it has to take over.
+ */
+class DriveHealth {
+ public:
+  /**
+   * Creates drive health monitoring.
+   *
+   * \param drive
+   *        Drive to watch.
+   */
+  DriveHealth(Drive &drive);
+
+  /**
+   * Tares every motor and starts the monitoring task, reccomended to run in initialize().
+   */
+  void initialize();
+
+  /**
+   * Tares every drive motor, so any of them can be the sensored motor without a jump.
+   */
+  void tare();
+
+  /**
+   * Returns the averaged left position in ticks.  Only changes with movement, tares don't reset it.
+   */
+  double get_left();
+
+  /**
+   * Returns the averaged right position in ticks.  Only changes with movement, tares don't reset it.
+   */
+  double get_right();
+
+  /**
+   * Returns the health of a motor.
+   *
+   * \param port
+   *        motor port, sign doesn't matter
+   */
+  motor_health get_health(int port);
+
+  /**
+   * Returns how many motors aren't MOTOR_OK.
+   */
+  int get_fault_count();
+
+  /**
+   * Returns how many times a sensored motor has been replaced.
+   */
+  int get_failover_count();
+
+  /**
+   * Prints each motor's health to the terminal.
+   */
+  void print_report();
+
+ private:
+  Drive &drive;
+
+  struct motor {
+    int port;
+    double last_position = 0;
+    bool started = false;
+    motor_health health = MOTOR_OK;
+    int busy_timer = 0;
+    int glitches = 0;
+    int glitch_timer = 0;
+    int healthy_timer = 0;
+  };
+
+  struct side {
+    std::vector<pros::Motor> *motors;
+    std::vector<motor> health;
+    double position = 0;
+    double last_delta = 0;
+  };
+
+  side left, right;
+  int failover_count = 0;
+  pros::Mutex mutex;
+
+  /**
+   * Ticks a motor's change can differ from the side before it's rejected.
+   */
+  const double OUTLIER_TICKS = 15;
+
+  motor_health check(pros::Motor &device, motor &m);
+  void update_side(side &s, std::string name);
+  void failover(side &s, std::string name);
+  void health_task();
+};
+
+/**
+ * Health monitoring for the chassis motors.
+ */
+extern DriveHealth driveHealth;
@@ -0,0 +1,186 @@
+#pragma once
+
+#include "EZ-Template/drive/drive.hpp"
+#include "imu_group.hpp"
+
+/**
+ * Alpha-beta filter, a steady state Kalman filter for position and velocity.
+ *
+ * Each measurement is compared to where the last velocity said it would be.
+ * alpha of the miss goes into position and beta of it into velocity, so
+ * velocity comes out smooth instead of jumping a whole encoder tick at a time.
+ */
+class AlphaBetaFilter {
+ public:
+  /**
+   * Creates a filter.
+   *
+   * \param alpha
+   *        0 to 1, how much position trusts each measurement
+   * \param beta
+   *        0 to 1, how much velocity trusts each measurement
+   */
+  AlphaBetaFilter(double alpha, double beta);
+
+  /**
+   * Sets position and zeroes velocity.
+   *
+   * \param position
+   *        starting position
+   */
+  void reset(double position);
+
+  /**
+   * Adds a measurement.
+   *
+   * \param measurement
+   *        measured position
+   * \param dt
+   *        seconds since the last measurement
+   */
+  void update(double measurement, double dt);
+
+  /**
+   * Filtered position.
+   */
+  double position = 0;
+
+  /**
+   * Filtered velocity, per second.
+   */
+  double velocity = 0;
+
+  double alpha;
+  double beta;
+};
+
+/**
+ * Drive encoders and heading, read with the time each sample was taken.
+ *
+ * Motors send their position over the smart port bus on their own schedule,
+ * so a control loop can read the same sample twice or skip one.
+ * left_sensor()/right_sensor() don't say which happened, so a difference
+ * per loop is noisy.  This reads get_raw_position() with its timestamp and
+ * only takes a velocity when a new sample arrives, over the real time
+ * between samples.  Reading the same sample again counts as stale.  The IMU
+ * has no timestamp, so its heading is timed when the reading changes.
+ *
+ * Distance and heading each go through an alpha-beta filter, and the filtered
+ * velocities are what the motions use for d and for exit conditions.
+ *
+ * Call update() once per loop in a motion, then read the values.
+ */
+class DriveSensors {
+ public:
+  /**
+   * Creates drive sensors.
+   *
+   * \param drive
+   *        Drive with the sensored motors.
+   * \param imus
+   *        IMU group to read heading from.
+   */
+  DriveSensors(Drive &drive, ImuGroup &imus);
+
+  /**
+   * Reads new samples.  Call once per loop.
+   */
+  void update();
+
+  /**
+   * Zeroes distance and velocities.
+   */
+  void reset();
+
+  /**
+   * Returns inches driven since reset(), the average of both sides.
+   */
+  double get_distance();
+
+  /**
+   * Returns filtered inches per second.
+   */
+  double get_velocity();
+
+  /**
+   * Returns unfiltered inches per second, the average of both sides over the last sample interval.
+   */
+  double get_raw_velocity();
+
+  /**
+   * Returns heading in degrees.
+   */
+  double get_heading();
+
+  /**
+   * Returns filtered degrees per second.
+   */
+  double get_heading_rate();
+
+  /**
+   * Sets the filter constants for distance and heading.
+   *
+   * \param alpha
+   *        0 to 1, how much position trusts each measurement
+   * \param beta
+   *        0 to 1, how much velocity trusts each measurement
+   */
+  void set_filter_constants(double alpha, double beta);
+
+  /**
+   * Returns true if the last update() got no new encoder sample on either side.
+   */
+  bool is_stale();
+
+  /**
+   * Returns the fraction of encoder reads since reset() that were stale, 0 to 1.
+   */
+  double get_stale_rate();
+
+  /**
+   * Returns average ms between new encoder samples.
+   */
+  double get_sample_interval();
+
+  /**
+   * Prints sample counts, stale rate and sample interval to the terminal.
+   */
+  void print_report();
+
+ private:
+  Drive &drive;
+  ImuGroup &imus;
+
+  struct side {
+    bool started = false;
+    int port = 0;
+    std::int32_t start = 0;
+    std::int32_t position = 0;
+    std::uint32_t time = 0;
+    double velocity = 0;
+  };
+  side left, right;
+
+  double heading = 0;
+  int heading_time = 0;
+
+  AlphaBetaFilter distance_filter{0.5, 0.15};
+  AlphaBetaFilter heading_filter{0.5, 0.15};
+  std::uint32_t distance_time = 0;
+
+  bool stale = false;
+  int reads = 0;
+  int stale_reads = 0;
+  int samples = 0;
+  std::uint32_t interval_sum = 0;
+
+  /**
+   * Reads one side, returns false if the sample is stale.
+   */
+  bool read(pros::Motor &motor, side &s);
+};
+
+/**
+ * Timestamped sensors for the chassis.
+ */
+extern DriveSensors driveSensors;
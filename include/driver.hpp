@@ -0,0 +1,148 @@
+#pragma once
+
+#include "api.h"
+#include "EZ-Template/util.hpp"
+
+/////
+//
+// Driver control that goes through EZ-Template's joystick curve, then our own
+// limits, then EZ-Template's joystick threshold and active brake.
+//
+/////
+
+/**
+ * Limits how fast a drive command can change.
+ *
+ * Slamming a stick asks the motors for full power at once, which spikes
+ * current, slips the wheels and can brown out the brain in a pushing war.
+ * This ramps the command instead, with separate rates for speeding up and
+ * slowing down so stopping can stay quick.  A jerk limit also ramps the rate
+ * itself, which smooths the start of the ramp.
+ */
+class AccelLimiter {
+ public:
+  /**
+   * Creates an acceleration limiter.
+   *
+   * \param up
+   *        change every ez::util::DELAY_TIME when speeding up, out of 127.  0 doesn't limit
+   * \param down
+   *        change every ez::util::DELAY_TIME when slowing down, out of 127.  0 doesn't limit
+   * \param jerk
+   *        change in the rate every ez::util::DELAY_TIME.  0 doesn't limit
+   */
+  AccelLimiter(double up = 0, double down = 0, double jerk = 0);
+
+  /**
+   * Returns the command moved toward target as far as the limits allow.
+   *
+   * \param target
+   *        -127 to 127
+   */
+  double step(double target);
+
+  /**
+   * Forgets the last output, the next step() ramps up from 0.
+   */
+  void reset();
+
+  /**
+   * Sets the limits.
+   *
+   * \param up
+   *        change every ez::util::DELAY_TIME when speeding up, out of 127.  0 doesn't limit
+   * \param down
+   *        change every ez::util::DELAY_TIME when slowing down, out of 127.  0 doesn't limit
+   * \param jerk
+   *        change in the rate every ez::util::DELAY_TIME.  0 doesn't limit
+   */
+  void set_limits(double up, double down, double jerk = 0);
+
+ private:
+  double up;
+  double down;
+  double jerk;
+  double output = 0;
+  double rate = 0;
+  int last_time = 0;
+};
+
+/**
+ * Sets the chassis to controller joysticks using tank control, like Drive::tank(), with acceleration limiting, heading assist, anti-tip and battery compensation.  Run in usercontrol.
+ *
+ * While both sticks are nearly equal the heading is held with headingPID, so
+ * the robot drives straight down long lanes without the driver correcting.
+ * Moving the sticks apart lets go right away.
+ *
+ * Pressing the position hold button locks the robot where it is, distance and
+ * heading, with a stiff PID and a friction feedforward so it fights back when
+ * pushed off a goal.  Any stick input lets go right away.
+ */
+void driver_tank();
+
+/**
+ * Sets the chassis to controller joysticks using standard arcade control, like Drive::arcade_standard(), with the same
+ * acceleration limiting, heading assist, position hold, anti-tip and battery compensation as driver_tank().  Run in usercontrol.
+ *
+ * \param stick_type
+ *        ez::SINGLE or ez::SPLIT control
+ */
+void driver_arcade(ez::e_type stick_type);
+
+/**
+ * Heading hold while driving straight in driver_tank().  True enables, false disables.
+ *
+ * \param toggle
+ *        bool input
+ * \param tolerance
+ *        sticks closer than this, out of 127, count as driving straight
+ */
+void set_heading_assist(bool toggle, double tolerance = 8);
+
+/**
+ * Sets the button that starts position hold.
+ *
+ * \param button
+ *        pros button, like pros::E_CONTROLLER_DIGITAL_X
+ */
+void set_position_hold_button(pros::controller_digital_e_t button);
+
+/**
+ * Sets constants for position hold.
+ *
+ * \param kp
+ *        output per inch pushed
+ * \param ki
+ *        ki
+ * \param kd
+ *        kD
+ * \param ks
+ *        output always added toward the held position once it's pushed off, to get past friction
+ * \param heading_kp
+ *        output per degree turned
+ * \param heading_kd
+ *        kD for heading
+ */
+void set_position_hold_constants(double kp, double ki, double kd, double ks, double heading_kp, double heading_kd);
+
+/**
+ * Returns true while position hold is on.
+ */
+bool is_holding_position();
+
+/**
+ * Sets acceleration limits for both sides in driver_tank().  All 0 turns the limiter off.
+ *
+ * \param up
+ *        change every ez::util::DELAY_TIME when speeding up, out of 127
+ * \param down
+ *        change every ez::util::DELAY_TIME when slowing down, out of 127
+ * \param jerk
+ *        change in the rate every ez::util::DELAY_TIME
+ */
+void set_driver_acceleration(double up, double down, double jerk = 0);
+
+/**
+ * Prints the highest average drive current during driver control to the terminal.
+ */
+void driver_print_report();
@@ -0,0 +1,124 @@
+#pragma once
+
+#include "EZ-Template/drive/drive.hpp"
+
+/**
+ * Fuses multiple inertial sensors into one heading for the Drive.
+ *
+ * Every tick the change in rotation of each healthy IMU is compared against
+ * the others, readings that disagree with the group are rejected, and the
+ * rest are averaged.  The fused heading is written back into Drive::imu so
+ * the built in turn, swing and heading PIDs use it.  If the IMU the Drive is
+ * reading from stops reporting, the Drive is moved onto a healthy IMU without
+ * a jump in heading.
+ *
+ * Moving the Drive rebuilds Drive::imu in place, mid motion too.  A pros::Imu
+ * only holds its port, so a reader in another task sees either the old port
+ * or the new one.
+ */
+class ImuGroup {
+ public:
+  /**
+   * Inertial sensors in the group.
+   */
+  std::vector<pros::Imu> imus;
+
+  /**
+   * Creates an IMU group.
+   *
+   * \param drive
+   *        Drive to feed the fused heading into.
+   * \param ports
+   *        Input {16, 17...}.  The first port must be the IMU port given to the Drive!
+   */
+  ImuGroup(Drive &drive, std::vector<int> ports);
+
+  /**
+   * Calibrates every IMU at the same time and starts the fusion task, reccomended to run in initialize().
+   * Returns true when at least one IMU calibrated.
+   *
+   * \param run_loading_animation
+   *        bool for running loading animation
+   */
+  bool initialize(bool run_loading_animation = true);
+
+  /**
+   * Returns the fused rotation in degrees.
+   */
+  double get_rotation();
+
+  /**
+   * Sets the fused rotation and every IMU to a new heading.  Use this instead of chassis.reset_gyro().
+   *
+   * \param new_heading
+   *        New heading value.
+   */
+  void reset(double new_heading = 0);
+
+  /**
+   * Sets the heading and the heading PID target.  Use this instead of chassis.set_angle().
+   *
+   * \param angle
+   *        New heading value.
+   */
+  void set_angle(double angle);
+
+  /**
+   * Returns true if the IMU at this index is reporting.
+   *
+   * \param index
+   *        index into imus
+   */
+  bool is_healthy(int index);
+
+  /**
+   * Returns how many IMUs are reporting.
+   */
+  int healthy_count();
+
+  /**
+   * Returns the index of the IMU the Drive is currently reading from.
+   */
+  int get_drive_index();
+
+  /**
+   * Sets how far, in degrees per tick, an IMU can disagree with the group before it is ignored.
+   *
+   * \param degrees
+   *        new threshold
+   */
+  void set_outlier_threshold(double degrees);
+
+ private:
+  Drive &drive;
+  std::vector<int> ports;
+  std::vector<double> last;
+  std::vector<bool> healthy;
+  double fused = 0;
+  double last_delta = 0;
+  double outlier_threshold = 1.0;
+  int drive_index = 0;
+  bool running = false;
+  pros::Mutex mutex;
+
+  /**
+   * Reads an IMU, returns false if it isn't reporting.
+   */
+  bool read(int index, double &output);
+
+  /**
+   * Points Drive::imu at a different port and gives it the fused heading.
+   */
+  void rebind_drive(int index);
+
+  /**
+   * Fuses every IMU once.
+   */
+  void update();
+  void imu_task();
+};
+
+/**
+ * IMU group for the chassis.
+ */
+extern ImuGroup imus;
@@ -0,0 +1,255 @@
+#pragma once
+
+#include "EZ-Template/PID.hpp"
+#include "api.h"
+
+/**
+ * Enum for the intake state machine.
+ */
+enum intake_state { INTAKE_IDLE = 0,
+                    INTAKE_INTAKING = 1,
+                    INTAKE_HOLDING = 2,
+                    INTAKE_OUTTAKING = 3 };
+
+/**
+ * Runs the intake from an optical sensor instead of timed guesses.
+ *
+ * intake() spins until a triball is seated in front of the optical sensor,
+ * then stops and holds.  outtake() spins the other way until the triball is
+ * gone.  This all runs in its own task, so autons keep driving and only wait
+ * on the intake with wait_until_held() / wait_until_empty() when they need to.
+ *
+ * The task also watches for jams.  When the motors pull high current without
+ * turning, the intake reverses for a moment and then goes back to what it was
+ * doing, so a wedged triball never cooks the motors.  A seated triball stalls
+ * the motors on purpose, so nothing is a jam while one is held.
+ *
+ * With velocity control on, speeds are a percent of the cartridge's free
+ * speed and the task holds that rpm with feedforward + PID, so intake speed
+ * doesn't change with battery voltage or how many triballs are loaded.
+ */
+class IntakeController {
+ public:
+  /**
+   * Optical sensor looking at the seated triball.
+   */
+  pros::Optical optical;
+
+  /**
+   * Creates an intake controller.
+   *
+   * \param motors
+   *        intake motors
+   * \param optical_port
+   *        Port the optical sensor is plugged into.
+   */
+  IntakeController(pros::Motor_Group &motors, int optical_port);
+
+  /**
+   * Starts the intake task, reccomended to run in initialize().
+   */
+  void initialize();
+
+  /**
+   * Spins the intake in until a triball is seated.
+   *
+   * \param speed
+   *        0 to 100
+   */
+  void intake(int speed = 100);
+
+  /**
+   * Spins the intake out until the triball is gone.
+   *
+   * \param speed
+   *        0 to 100
+   */
+  void outtake(int speed = 100);
+
+  /**
+   * Stops the intake.
+   */
+  void stop();
+
+  /**
+   * Spins the intake at a fixed speed, leaving the state machine idle.
+   *
+   * \param speed
+   *        -100 to 100
+   */
+  void move(int speed);
+
+  /**
+   * Returns the current state.
+   */
+  intake_state get_state();
+
+  /**
+   * Returns true if the optical sensor sees a triball.
+   */
+  bool has_triball();
+
+  /**
+   * Blocks until a triball is seated.  Returns false if it timed out.
+   *
+   * \param timeout
+   *        max time to wait in ms
+   */
+  bool wait_until_held(int timeout = 1000);
+
+  /**
+   * Blocks until the outtake finishes.  Returns false if it timed out.
+   *
+   * \param timeout
+   *        max time to wait in ms
+   */
+  bool wait_until_empty(int timeout = 1000);
+
+  /**
+   * Sets what counts as a triball.
+   *
+   * \param proximity
+   *        0 to 255, minimum proximity reading
+   * \param hue_min
+   *        lowest hue, 0 to 360
+   * \param hue_max
+   *        highest hue, 0 to 360.  If lower than hue_min the range wraps past 360
+   */
+  void set_detection(int proximity, double hue_min, double hue_max);
+
+  /**
+   * Sets what counts as a jam and how long to reverse for.
+   *
+   * \param current
+   *        0 to 1, average current above this fraction of the motors' current limit is stalling
+   * \param velocity
+   *        average rpm below this is stalling
+   * \param time
+   *        ms of stalling before unjamming
+   * \param unjam
+   *        ms to reverse for
+   */
+  void set_stall_detection(double current, double velocity, int time, int unjam);
+
+  /**
+   * Holds rpm with feedforward + PID instead of sending a fixed voltage.  True enables, false disables.
+   *
+   * \param toggle
+   *        bool input
+   */
+  void set_velocity_control(bool toggle);
+
+  /**
+   * Sets the rpm a full command asks for under velocity control, as a fraction of the cartridge's free speed.
+   *
+   * \param fraction
+   *        0.1 to 1, the intake can't hold free speed with a triball in it
+   */
+  void set_top_speed(double fraction);
+
+  /**
+   * Sets constants for velocity control.
+   *
+   * \param kv
+   *        feedforward, mV per rpm
+   * \param kp
+   *        mV per rpm of error
+   * \param ki
+   *        ki
+   * \param start_i
+   *        rpm error that i starts within
+   */
+  void set_velocity_constants(double kv, double kp, double ki = 0, double start_i = 0);
+
+  /**
+   * Returns the rpm being asked for.
+   */
+  double get_target_rpm();
+
+  /**
+   * Returns the average rpm of the intake motors.
+   */
+  double get_actual_rpm();
+
+  /**
+   * Returns achieved rpm divided by requested rpm over everything the intake has run, 1 is perfect.
+   */
+  double get_tracking_ratio();
+
+  /**
+   * Returns how many triballs have been seated by intake().
+   */
+  int get_triball_count();
+
+  /**
+   * Returns the average ms from intake() to a seated triball.
+   */
+  double get_average_intake_time();
+
+  /**
+   * Returns how many jams there have been.
+   */
+  int get_jam_count();
+
+  /**
+   * Returns ms spent stalled or unjamming.
+   */
+  int get_time_lost();
+
+ private:
+  pros::Motor_Group &motors;
+  intake_state state = INTAKE_IDLE;
+  int speed = 100;
+  int seen_timer = 0;
+  int clear_timer = 0;
+  int detect_proximity = 200;
+  double hue_min = 0;
+  double hue_max = 360;
+  pros::task_t waiter = nullptr;
+  int manual_voltage = 0;
+
+  // Velocity control
+  bool velocity_control = false;
+  double max_rpm = 200;
+  double top_speed = 0.85;
+  double kv = 60;
+  PID velocity_pid{20, 0.5, 0, 30};
+  double target_rpm = 0;
+  double requested_sum = 0;
+  double achieved_sum = 0;
+  int intake_timer = 0;
+  int triball_count = 0;
+  int intake_time_sum = 0;
+
+  // Jam detection
+  double stall_current = 0.8;
+  double stall_velocity = 20;
+  int stall_time = 150;
+  int unjam_time = 150;
+  int stall_timer = 0;
+  int unjam_timer = 0;
+  int grace_timer = 0;
+  int last_command = 0;
+  int jam_command = 0;
+  int jam_count = 0;
+  int time_lost = 0;
+
+  /**
+   * Returns true if the motors are pulling current without turning.
+   */
+  bool is_stalled();
+
+  /**
+   * Wakes up an auton waiting in wait_until_held() or wait_until_empty().
+   */
+  void signal();
+  bool wait_for(intake_state done, int timeout);
+
+  void update();
+  void intake_task();
+};
+
+/**
+ * Intake controller for the Intake motor group.
+ */
+extern IntakeController intakeController;
@@ -0,0 +1,135 @@
+#pragma once
+
+#include <functional>
+
+#include "EZ-Template/drive/drive.hpp"
+#include "drive_sensors.hpp"
+#include "drive_health.hpp"
+#include "imu_group.hpp"
+
+/**
+ * Enum for what's interfering with the drive.
+ */
+enum interference_type { INTERFERENCE_NONE = 0,
+                         INTERFERENCE_STALLED = 1,
+                         INTERFERENCE_PUSHED_BACK = 2,
+                         INTERFERENCE_SPUN = 3 };
+
+/**
+ * Notices when another robot is pinning, pushing or spinning ours.
+ *
+ * Drive::interfered only goes true after the mA timeout, long after a motion
+ * has been lost.  Here the voltage each side is given goes through a simple
+ * model of the drive, a first order lag to free speed, and what the wheels
+ * and IMU actually do is compared to it every tick.  100ms of disagreement is
+ * interference, classified as:
+ *  - stalled, driving hard and barely moving
+ *  - pushed back, moving the opposite way to the model
+ *  - spun, turning when the model isn't, or the opposite way to it
+ *
+ * Autons can check get_state(), block on wait_for(), or add a callback that
+ * runs the moment it's detected.
+ */
+class InterferenceDetector {
+ public:
+  /**
+   * Creates an interference detector.
+   *
+   * \param drive
+   *        Drive to watch.
+   * \param health
+   *        averaged drive encoders
+   * \param imus
+   *        IMU group to read heading from.
+   */
+  InterferenceDetector(Drive &drive, DriveHealth &health, ImuGroup &imus);
+
+  /**
+   * Starts the detection task, reccomended to run in initialize().
+   */
+  void initialize();
+
+  /**
+   * Returns what's interfering right now.
+   */
+  interference_type get_state();
+
+  /**
+   * Returns how many times interference has been detected.
+   */
+  int get_count();
+
+  /**
+   * Blocks until interference is detected.  Returns what it was, or INTERFERENCE_NONE if it timed out.
+   *
+   * \param timeout
+   *        max time to wait in ms
+   */
+  interference_type wait_for(int timeout);
+
+  /**
+   * Runs a function from the detection task the moment interference is detected.  Keep it short.
+   *
+   * \param callback
+   *        function given what was detected
+   */
+  void on_interference(std::function<void(interference_type)> callback);
+
+  /**
+   * Sets the drive model.
+   *
+   * \param lag
+   *        seconds for the drive to get most of the way to a new speed
+   * \param stall_fraction
+   *        0 to 1, stalled when moving slower than this fraction of the model, and spun when turning against it by more than this fraction
+   * \param spin_rate
+   *        degrees per second of turning that isn't asked for
+   */
+  void set_model(double lag, double stall_fraction, double spin_rate);
+
+  /**
+   * Sets the distance between the left and right wheels, used to work out how fast the model should be turning.
+   *
+   * \param track_width
+   *        inches
+   */
+  void set_track_width(double track_width);
+
+ private:
+  Drive &drive;
+  DriveHealth &health;
+  ImuGroup &imus;
+
+  AlphaBetaFilter left_filter{0.5, 0.15};
+  AlphaBetaFilter right_filter{0.5, 0.15};
+  AlphaBetaFilter heading_filter{0.5, 0.15};
+  double left_model = 0;
+  double right_model = 0;
+
+  double lag = 0.15;
+  double stall_fraction = 0.2;
+  double spin_rate = 120;
+  double track_width = 11.5;
+
+  interference_type state = INTERFERENCE_NONE;
+  int stall_timer = 0;
+  int push_timer = 0;
+  int spin_timer = 0;
+  int clear_timer = 0;
+  int count = 0;
+  pros::task_t waiter = nullptr;
+  std::function<void(interference_type)> callback = nullptr;
+
+  /**
+   * Returns volts given to a side, or 0 if it can't be read.
+   */
+  double get_command(std::vector<pros::Motor> &motors);
+
+  void update();
+  void interference_task();
+};
+
+/**
+ * Interference detector for the chassis.
+ */
+extern InterferenceDetector interference;
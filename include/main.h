@@ -44,6 +44,23 @@
 #include "EZ-Template/api.hpp"
 #include "autons.hpp"
 #include "Subsystems.hpp"
+#include "battery.hpp"
+#include "thermal.hpp"
+#include "current_arbiter.hpp"
+#include "imu_group.hpp"
+#include "odometry.hpp"
+#include "drive_health.hpp"
+#include "drive_sensors.hpp"
+#include "interference.hpp"
+#include "traction.hpp"
+#include "anti_tip.hpp"
+#include "driver.hpp"
+#include "rate_pid.hpp"
+#include "motions.hpp"
+#include "intake.hpp"
+#include "catapult.hpp"
+#include "pneumatics.hpp"
+#include "scheduler.hpp"
 
 // More includes here...
 //
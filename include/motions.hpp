@@ -0,0 +1,140 @@
+#pragma once
+
+#include "EZ-Template/drive/drive.hpp"
+
+/////
+//
+// Motions that EZ-Template doesn't have.  These take over the drive from
+// set_drive_pid/set_turn_pid while they run and reuse the tuned constants
+// from default_constants().  Each one blocks until it settles, like
+// set_drive_pid + wait_drive.
+//
+/////
+
+/**
+ * A distance sensor on the drive.
+ */
+class WallSensor {
+ public:
+  /**
+   * Distance sensor.
+   */
+  pros::Distance sensor;
+
+  /**
+   * Inches from the center of turning to the face of the sensor.
+   */
+  double offset;
+
+  /**
+   * True if the sensor is on the back of the robot.
+   */
+  bool backwards;
+
+  /**
+   * Creates a wall sensor.
+   *
+   * \param port
+   *        Port the distance sensor is plugged into.
+   * \param offset
+   *        Inches from the center of turning to the face of the sensor.
+   * \param backwards
+   *        True if the sensor faces the back of the robot.
+   */
+  WallSensor(int port, double offset, bool backwards = false);
+
+  /**
+   * Reads the sensor in inches.  Returns false if nothing is in range.
+   *
+   * \param inches
+   *        output
+   */
+  bool get(double &inches);
+};
+
+/**
+ * A wall at a known place on the field, used to re-zero odometry.
+ */
+struct field_wall {
+  /**
+   * True if the wall is a line of constant x, false if it's constant y.
+   */
+  bool is_x;
+
+  /**
+   * x or y of the wall in inches.
+   */
+  double position;
+
+  /**
+   * Heading a sensor faces when it is square to the wall.
+   */
+  double heading;
+};
+
+/**
+ * Drives until the sensor reads target, holding heading.  Returns false if the sensor lost the wall.
+ *
+ * \param sensor
+ *        sensor pointed at the wall
+ * \param target
+ *        sensor reading to stop at, in inches
+ * \param speed
+ *        0 to 127, max speed during motion
+ * \param wall
+ *        if given, the tracked position is re-zeroed from this wall
+ */
+bool drive_to_wall(WallSensor &sensor, double target, int speed, const field_wall *wall = nullptr);
+
+/**
+ * Turns in place until both sensors read the same.  Returns false if either sensor lost the wall.
+ *
+ * \param left
+ *        sensor on the left side of the robot
+ * \param right
+ *        sensor on the right side of the robot, facing the same way as left
+ * \param spacing
+ *        inches between the two sensors
+ * \param speed
+ *        0 to 127, max speed during motion
+ * \param wall
+ *        if given, heading and position are re-zeroed from this wall
+ */
+bool square_to_wall(WallSensor &left, WallSensor &right, double spacing, int speed, const field_wall *wall = nullptr);
+
+/**
+ * Drives toward target and stops the moment the robot hits something, instead of waiting out the velocity or mA exit.
+ * Contact is when the drive moves much slower than the command should make it, and either drive current is high or
+ * there was an IMU acceleration spike in the last 200ms.  Spikes while the command is still ramping don't count.
+ * Heading is held at headingPID's target, like set_drive_pid.
+ * Returns how far the robot actually travelled in inches.
+ *
+ * \param target
+ *        target value in inches, the furthest the push will go
+ * \param speed
+ *        0 to 127, max speed during motion
+ */
+double push(double target, int speed);
+
+/**
+ * Returns true if the last push() stopped because it made contact.
+ */
+bool push_made_contact();
+
+/**
+ * Sets the contact thresholds for push().
+ *
+ * \param accel
+ *        acceleration spike in g
+ * \param velocity_drop
+ *        0 to 1, stopped when velocity falls below this fraction of the speed the command should give
+ * \param mA
+ *        average drive current
+ */
+void set_push_thresholds(double accel, double velocity_drop, int mA);
+
+/**
+ * Distance sensors on the back of the chassis.
+ */
+extern WallSensor back_left_wall;
+extern WallSensor back_right_wall;
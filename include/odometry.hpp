@@ -0,0 +1,212 @@
+#pragma once
+
+#include "EZ-Template/drive/drive.hpp"
+#include "imu_group.hpp"
+
+/**
+ * Field position.  x and y are inches, theta is degrees clockwise (the same direction as the IMU).
+ */
+struct pose {
+  double x = 0;
+  double y = 0;
+  double theta = 0;
+};
+
+/**
+ * Tracks the robot's position on the field from the drive encoders and the IMU group.
+ *
+ * An optional GPS sensor corrects the tracked position.  Each GPS reading is
+ * weighted against how far the robot has driven since the last correction,
+ * using get_error() as the GPS's uncertainty.  Position corrections are eased
+ * in a little every tick, and heading corrections are only given to the IMUs
+ * while the drive is settled so they never kick a motion that is running.
+ *
+ * Readings are only fused after set_pose_from_gps(), set_pose() stops them
+ * again, since a pose from the robot's start isn't in the GPS's field frame.
+ * Only the heading correction reaches EZ-Template's motions, through the
+ * IMUs.  Position corrections move get_pose(), not drive targets.
+ */
+class Odometry {
+ public:
+  /**
+   * Creates odometry.
+   *
+   * \param drive
+   *        Drive to read encoders from.
+   * \param imus
+   *        IMU group to read heading from.
+   */
+  Odometry(Drive &drive, ImuGroup &imus);
+
+  /**
+   * Starts the tracking task, reccomended to run in initialize() after the IMUs calibrate.
+   */
+  void initialize();
+
+  /**
+   * Returns the current position.
+   */
+  pose get_pose();
+
+  /**
+   * Sets the current position.  GPS readings aren't fused until set_pose_from_gps() is called.
+   *
+   * \param x
+   *        inches
+   * \param y
+   *        inches
+   * \param theta
+   *        degrees
+   */
+  void set_pose(double x, double y, double theta);
+
+  /**
+   * Sets x, leaving y and heading alone.
+   *
+   * \param x
+   *        inches
+   */
+  void set_x(double x);
+
+  /**
+   * Sets y, leaving x and heading alone.
+   *
+   * \param y
+   *        inches
+   */
+  void set_y(double y);
+
+  /**
+   * Sets the heading by moving the IMUs, so turns after this use the new heading.
+   *
+   * \param theta
+   *        degrees
+   */
+  void set_heading(double theta);
+
+  /**
+   * Sets the position from the GPS, waiting up to timeout for a good reading, and starts fusing GPS readings.  Returns true if it was set.
+   *
+   * \param timeout
+   *        time to wait in ms
+   */
+  bool set_pose_from_gps(int timeout = 200);
+
+  /**
+   * Adds a GPS sensor.
+   *
+   * \param port
+   *        Port the GPS is plugged into.
+   * \param x_offset
+   *        Meters right of the center of turning.
+   * \param y_offset
+   *        Meters forward of the center of turning.
+   */
+  void set_gps(int port, double x_offset = 0, double y_offset = 0);
+
+  /**
+   * Sets how often the GPS is read.
+   *
+   * \param ms
+   *        time between readings, 5ms minimum
+   */
+  void set_gps_data_rate(int ms);
+
+  /**
+   * Sets how much the tracked position can be trusted.
+   *
+   * \param drift
+   *        expected error per inch travelled, 0.02 is 2%
+   * \param max_gps_error
+   *        GPS readings with a get_error() above this, in inches, are ignored
+   */
+  void set_gps_trust(double drift, double max_gps_error);
+
+  /**
+   * Sets how fast corrections are eased in.
+   *
+   * \param inches
+   *        max position correction per tick
+   * \param degrees
+   *        max heading correction each time the drive settles
+   */
+  void set_correction_rate(double inches, double degrees);
+
+  /**
+   * Fuses one absolute position reading.  The GPS uses this, and it can be called with any other position source.
+   *
+   * \param measured
+   *        measured position
+   * \param error
+   *        RMS error of the measurement in inches
+   */
+  void fuse(pose measured, double error);
+
+  /**
+   * Takes back distance the encoders counted but the robot didn't travel, like wheel slip.
+   *
+   * \param inches
+   *        distance along the current heading, positive if the encoders overcounted forward
+   */
+  void remove_distance(double inches);
+
+  /**
+   * Returns the RMS difference in inches between the GPS and the tracked position.
+   */
+  double get_gps_residual();
+
+  /**
+   * Returns how many GPS readings have been fused.
+   */
+  int get_gps_count();
+
+ private:
+  Drive &drive;
+  ImuGroup &imus;
+  pros::Gps *gps = nullptr;
+  int gps_data_rate = 20;
+  int gps_timer = 0;
+  bool gps_seeded = false;
+
+  pose current;
+  double heading_offset = 0;
+  double last_left = 0;
+  double last_right = 0;
+  double last_rotation = 0;
+
+  // Variance of the tracked position and heading
+  double position_variance = 0;
+  double heading_variance = 0;
+  double drift = 0.02;
+  double max_gps_error = 6;
+
+  // Corrections waiting to be eased in
+  double pending_x = 0;
+  double pending_y = 0;
+  double pending_theta = 0;
+  double max_correction = 0.05;
+  double max_heading_correction = 1.0;
+  int settle_timer = 0;
+
+  double residual_sum = 0;
+  int gps_count = 0;
+  pros::Mutex mutex;
+
+  /**
+   * Reads the GPS, returns false if there isn't a good reading.
+   */
+  bool read_gps(pose &output, double &error);
+
+  /**
+   * Fuses a reading, the caller holds the mutex.
+   */
+  void correct(pose measured, double error);
+
+  void update();
+  void odom_task();
+};
+
+/**
+ * Odometry for the chassis.
+ */
+extern Odometry odom;
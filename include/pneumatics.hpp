@@ -0,0 +1,220 @@
+#pragma once
+
+#include "api.h"
+
+/**
+ * Estimates how much air is left.
+ *
+ * Every actuator change fills a cylinder from the tanks, so each one drops
+ * the tank pressure by the ratio of the tank volume to tank plus cylinder
+ * volume.  Pressure is estimated from that alone, there is no sensor.
+ */
+class AirSupply {
+ public:
+  /**
+   * Creates an air supply.
+   *
+   * \param tank_volume
+   *        mL of every tank together
+   * \param start_pressure
+   *        psi the tanks are pumped to
+   * \param min_pressure
+   *        psi below which pistons stop working reliably
+   */
+  AirSupply(double tank_volume, double start_pressure, double min_pressure);
+
+  /**
+   * Takes air for one cylinder stroke.
+   *
+   * \param volume
+   *        mL filled
+   */
+  void use(double volume);
+
+  /**
+   * Returns the estimated pressure in psi.
+   */
+  double get_pressure();
+
+  /**
+   * Returns the estimated pressure after strokes of a volume, without using the air.
+   *
+   * \param volume
+   *        mL filled each stroke
+   * \param strokes
+   *        number of strokes
+   */
+  double pressure_after(double volume, int strokes = 1);
+
+  /**
+   * Returns how many strokes have been taken.
+   */
+  int get_actuation_count();
+
+  /**
+   * Resets the estimate after pumping the tanks.
+   *
+   * \param pressure
+   *        psi the tanks are pumped to
+   */
+  void reset(double pressure);
+
+  /**
+   * Sets the pressure that warns the driver.
+   *
+   * \param pressure
+   *        psi
+   */
+  void set_warning(double pressure);
+
+  /**
+   * Rumbles and prints to the top line of the controller the first time the estimate falls below the warning.  The pneumatics task calls this.
+   */
+  void update();
+
+  /**
+   * Minimum working pressure in psi.
+   */
+  double min_pressure;
+
+ private:
+  double tank_volume;
+  double pressure;
+  double warning_pressure;
+  bool warned = false;
+  int actuation_count = 0;
+};
+
+/**
+ * A solenoid that can be timed without blocking.
+ *
+ * pulse(), deploy_after() and retract_after_distance() return right away, and
+ * a shared pneumatics task flips the solenoid when the time or distance is
+ * reached.  Autons can start the next motion while a piston is still out.
+ * Calling set() cancels anything scheduled.
+ */
+class Actuator {
+ public:
+  /**
+   * Creates an actuator.
+   *
+   * \param port
+   *        3 wire port, 'A' to 'H'
+   * \param initial
+   *        state at startup
+   * \param volume
+   *        mL filled each time the solenoid changes, all cylinders and tubing on this solenoid
+   */
+  Actuator(char port, bool initial = false, double volume = 4.0);
+
+  /**
+   * Sets the solenoid now, cancelling anything scheduled.
+   *
+   * \param state
+   *        true extends, false retracts
+   */
+  void set(bool state);
+
+  /**
+   * Returns the current state.
+   */
+  bool get();
+
+  /**
+   * Flips the current state.
+   */
+  void toggle();
+
+  /**
+   * Extends now and retracts after a time.
+   *
+   * \param duration
+   *        ms to stay extended
+   */
+  void pulse(int duration);
+
+  /**
+   * Extends after a time.
+   *
+   * \param delay
+   *        ms to wait
+   */
+  void deploy_after(int delay);
+
+  /**
+   * Retracts after a time.
+   *
+   * \param delay
+   *        ms to wait
+   */
+  void retract_after(int delay);
+
+  /**
+   * Retracts after the drive has travelled a distance, in either direction.
+   *
+   * \param inches
+   *        distance from now
+   */
+  void retract_after_distance(double inches);
+
+  /**
+   * Returns how many times the solenoid has changed.
+   */
+  int get_count();
+
+  /**
+   * Returns true if the tanks have enough air for this many more changes.
+   *
+   * \param changes
+   *        extends and retracts both count as a change
+   */
+  bool can_afford(int changes = 1);
+
+  /**
+   * Returns true if something is scheduled.
+   */
+  bool is_pending();
+
+  /**
+   * Runs anything scheduled that is due.  The pneumatics task calls this for every actuator.
+   */
+  void update();
+
+ private:
+  pros::ADIDigitalOut piston;
+  bool state;
+  double volume;
+  int count = 0;
+
+  /**
+   * Writes the solenoid, taking air when it changes.
+   */
+  void apply(bool state);
+
+  // One scheduled change at a time
+  bool pending = false;
+  bool pending_state = false;
+  int pending_time = 0;
+  double pending_distance = 0;
+  double start_distance = 0;
+
+  void schedule(bool target, int delay, double distance);
+};
+
+/**
+ * Starts the task that runs scheduled actuator changes, reccomended to run in initialize().
+ */
+void pneumatics_initialize();
+
+/**
+ * Air tanks on the robot.
+ */
+extern AirSupply air;
+
+/**
+ * Pistons on the robot.
+ */
+extern Actuator wingActuation;
+extern Actuator blockerActuation;
+extern Actuator chomperactuation;
+extern Actuator BwingActuation;
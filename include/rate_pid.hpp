@@ -0,0 +1,111 @@
+#pragma once
+
+#include "EZ-Template/PID.hpp"
+
+/**
+ * PID for the custom motions that works at any loop period.
+ *
+ * EZ-Template's PID adds error to i and takes the change in error for d once
+ * per call, so its constants only mean something at ez::util::DELAY_TIME.
+ * This scales i by dt and d by 1/dt relative to ez::util::DELAY_TIME, so
+ * constants tuned at 10ms give the same response at 5ms or 20ms.  The exit
+ * timers still come from EZ-Template's PID, ticked once for every
+ * ez::util::DELAY_TIME that has passed.  The velocity exit uses the same
+ * derivative as d, so a measured rate passed to compute() settles both.
+ */
+class RatePID {
+ public:
+  /**
+   * EZ-Template PID holding constants, target and exit conditions.
+   */
+  PID pid;
+
+  /**
+   * Constructor with constants.
+   *
+   * \param p
+   *        kP
+   * \param i
+   *        ki, tuned at ez::util::DELAY_TIME
+   * \param d
+   *        kD, tuned at ez::util::DELAY_TIME
+   * \param start_i
+   *        error value that i starts within
+   * \param name
+   *        std::string of name that prints
+   */
+  RatePID(double p, double i = 0, double d = 0, double start_i = 0, std::string name = "");
+
+  /**
+   * Set's target and restarts timing.
+   *
+   * \param target
+   *        Target for PID.
+   */
+  void set_target(double target);
+
+  /**
+   * Set's constants for exit conditions, same as PID::set_exit_condition().
+   */
+  void set_exit_condition(int small_exit_time, double small_error, int big_exit_time = 0, double big_error = 0, int velocity_exit_time = 0, int mA_timeout = 0);
+
+  /**
+   * Computes PID using the real time since the last call.
+   *
+   * \param current
+   *        Current sensor value.
+   */
+  double compute(double current);
+
+  /**
+   * Computes PID with a derivative from a measured rate instead of the change in error.
+   *
+   * \param current
+   *        Current sensor value.
+   * \param rate
+   *        rate of change of current, per ez::util::DELAY_TIME
+   */
+  double compute(double current, double rate);
+
+  /**
+   * Iterative exit condition.  Prints the settle time when a named PID exits.
+   *
+   * \param sensor
+   *        Pros motors on your mechanism.
+   */
+  ez::exit_output exit_condition(std::vector<pros::Motor> sensor);
+
+  /**
+   * Returns ms since set_target().
+   */
+  int get_elapsed();
+
+ private:
+  std::string name;
+  double prev_error = 0;
+  bool first = true;
+  double integral = 0;
+  int start_time = 0;
+  int prev_time = 0;
+  int exit_time = 0;
+  int exit_ticks = 0;
+  ez::exit_output last_exit = ez::RUNNING;
+
+  /**
+   * Updates i and returns dt in ez::util::DELAY_TIME ticks.
+   */
+  double step(double error);
+};
+
+/**
+ * Sets the loop period for the custom motions.
+ *
+ * \param ms
+ *        5, 10 or 20
+ */
+void set_control_rate(int ms);
+
+/**
+ * Returns the loop period for the custom motions in ms.
+ */
+int get_control_rate();
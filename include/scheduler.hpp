@@ -0,0 +1,90 @@
+#pragma once
+
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "api.h"
+
+/**
+ * Runs driver control jobs at their own rates in one task.
+ *
+ * Each job is added with a period and a priority.  run() wakes up every tick,
+ * runs the jobs that are due from highest priority to lowest, and times each
+ * one.  If a tick runs over its budget the rest of the due jobs wait for the
+ * next tick, so a slow display never delays the drive.  Jobs that waited run
+ * first among their own priority on the next tick, so one job can't be put
+ * off forever by others at its level.
+ */
+class Scheduler {
+ public:
+  /**
+   * Creates a scheduler.
+   *
+   * \param tick
+   *        ms between wake ups, every period should be a multiple of this
+   */
+  Scheduler(int tick = 10);
+
+  /**
+   * Adds a job.  Jobs can't be removed.
+   *
+   * \param name
+   *        name in the report
+   * \param job
+   *        function to run
+   * \param period
+   *        ms between runs
+   * \param priority
+   *        higher runs first when jobs are due on the same tick
+   */
+  void add(std::string name, std::function<void()> job, int period, int priority = 0);
+
+  /**
+   * Runs the jobs forever, call this at the end of opcontrol().
+   */
+  void run();
+
+  /**
+   * Sets how much of each tick the jobs can use before the rest wait.
+   *
+   * \param fraction
+   *        0 to 1
+   */
+  void set_budget(double fraction);
+
+  /**
+   * Clears run counts and times.
+   */
+  void reset_stats();
+
+  /**
+   * Prints each job's period, run count, average and worst time, and times it waited to the terminal.
+   */
+  void print_report();
+
+ private:
+  struct job {
+    std::string name;
+    std::function<void()> function;
+    int period;
+    int priority;
+    int next_run = 0;
+    bool waiting = false;
+    int runs = 0;
+    int deferred = 0;
+    uint64_t total_us = 0;
+    uint64_t worst_us = 0;
+  };
+
+  std::vector<job> jobs;
+  std::vector<job *> due;
+  int tick;
+  double budget = 0.8;
+  int overruns = 0;
+};
+
+/**
+ * Scheduler for driver control.
+ */
+extern Scheduler driverScheduler;
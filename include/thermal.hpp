@@ -0,0 +1,122 @@
+#pragma once
+
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "api.h"
+
+/**
+ * Predicts when motors will overheat and backs them off before they do.
+ *
+ * V5 motors halve their power at 55C without saying anything, which is a
+ * cliff in the middle of a skills run.  Each motor's temperature is modelled
+ * from its current, heating with current squared and cooling toward the
+ * temperature it started at, and kept inside the 5C steps the sensor reads.
+ * The model gives a time until throttling.  When a group's time gets inside
+ * the horizon, its derate callback is given a factor that slides from 1 down
+ * to the minimum, so the group slows a little early instead of a lot late.
+ */
+class ThermalMonitor {
+ public:
+  /**
+   * Creates a thermal monitor.
+   */
+  ThermalMonitor();
+
+  /**
+   * Adds a group of motors.
+   *
+   * \param name
+   *        short name for the controller screen
+   * \param motors
+   *        motors in the group
+   * \param derate
+   *        called with 0 to 1 when the factor changes, 1 is full power
+   */
+  void add_group(std::string name, std::vector<pros::Motor> motors, std::function<void(double)> derate);
+
+  /**
+   * Starts the monitoring task, reccomended to run in initialize().
+   */
+  void initialize();
+
+  /**
+   * Returns seconds until the hottest motor in a group throttles, or -1 if it isn't heating.
+   *
+   * \param name
+   *        group name
+   */
+  double get_time_to_throttle(std::string name);
+
+  /**
+   * Returns the derate factor of a group, 1 is full power.
+   *
+   * \param name
+   *        group name
+   */
+  double get_derate(std::string name);
+
+  /**
+   * Sets when derating starts and how far it goes.
+   *
+   * \param horizon
+   *        seconds to throttle where derating starts
+   * \param min_derate
+   *        0 to 1, factor right before throttling
+   */
+  void set_derating(double horizon, double min_derate);
+
+  /**
+   * Sets the heating model.
+   *
+   * \param heat
+   *        C per second per amp squared
+   * \param cool
+   *        fraction of the difference from starting temperature lost per second
+   */
+  void set_model(double heat, double cool);
+
+  /**
+   * Prints each group's temperatures, time to throttle, derate and firmware throttles to the terminal.
+   */
+  void print_report();
+
+ private:
+  struct motor {
+    pros::Motor device;
+    double temperature = 0;
+    double ambient = 0;
+    double current_squared = 0;
+    double time_to_throttle = -1;
+    bool throttled = false;
+  };
+
+  struct group {
+    std::string name;
+    std::vector<motor> motors;
+    std::function<void(double)> derate;
+    double time_to_throttle = -1;
+    double factor = 1;
+    int throttle_count = 0;
+  };
+
+  std::vector<group> groups;
+  double horizon = 20;
+  double min_derate = 0.5;
+  double heat = 0.08;
+  double cool = 0.01;
+
+  // Motors halve power here
+  const double THROTTLE_TEMPERATURE = 55;
+
+  group *find(std::string name);
+  void update_motor(motor &m, double dt);
+  void update();
+  void thermal_task();
+};
+
+/**
+ * Thermal monitor for the drive and catapult.
+ */
+extern ThermalMonitor thermals;
@@ -0,0 +1,116 @@
+#pragma once
+
+#include "EZ-Template/drive/drive.hpp"
+#include "drive_health.hpp"
+#include "drive_sensors.hpp"
+
+/**
+ * Catches wheel slip and backs off torque until the wheels grip again.
+ *
+ * The IMU's forward acceleration is integrated into a velocity that's pulled
+ * gently toward the encoder velocity while the wheels grip, so the two only
+ * split apart when the encoders accelerate differently than the robot does.
+ * That split is slip, from spinning the wheels at the start of a push or
+ * skidding on a hard stop.  While slipping the drive's share of current is
+ * cut, and the distance the encoders counted that the IMU didn't see is taken
+ * back out of odometry.  One slip lasts at most half a second and takes out at
+ * most 3 inches, so a bump that throws off the IMU can't latch it.  Slip isn't
+ * checked while the robot is tilted, like climbing the bar, since gravity
+ * reads as acceleration then.
+ */
+class TractionControl {
+ public:
+  /**
+   * Creates traction control.
+   *
+   * \param drive
+   *        Drive to watch.
+   * \param health
+   *        averaged drive encoders
+   */
+  TractionControl(Drive &drive, DriveHealth &health);
+
+  /**
+   * Starts the traction task, reccomended to run in initialize() after the IMUs calibrate, with the robot flat.
+   */
+  void initialize();
+
+  /**
+   * Returns true while the wheels are slipping.
+   */
+  bool is_slipping();
+
+  /**
+   * Returns how many times the wheels have started slipping.
+   */
+  int get_slip_count();
+
+  /**
+   * Returns inches of slip taken out of odometry.
+   */
+  double get_slip_distance();
+
+  /**
+   * Sets which IMU axis points forward.
+   *
+   * \param axis
+   *        'x' or 'y'
+   * \param reversed
+   *        true if the axis points backward
+   */
+  void set_forward_axis(char axis, bool reversed = false);
+
+  /**
+   * Sets what counts as slip and how hard to back off.
+   *
+   * \param speed
+   *        inches per second the encoders and IMU can disagree before it's slip
+   * \param torque
+   *        0 to 1, fraction of drive current while slipping
+   */
+  void set_slip_detection(double speed, double torque);
+
+  /**
+   * Prints slip events and distance to the terminal.
+   */
+  void print_report();
+
+ private:
+  Drive &drive;
+  DriveHealth &health;
+
+  AlphaBetaFilter encoder_filter{0.5, 0.15};
+  double imu_velocity = 0;
+  char axis = 'y';
+  bool reversed = false;
+
+  // Past this many degrees of pitch or roll, gravity swamps the forward acceleration
+  double max_tilt = 3;
+  double pitch_zero = 0;
+  double roll_zero = 0;
+
+  double slip_speed = 6;
+  double slip_torque = 0.6;
+  double torque = 1;
+
+  bool slipping = false;
+  int slip_timer = 0;
+  int slip_duration = 0;
+  double event_distance = 0;
+
+  // Slip longer or further than this is the IMU drifting, not the wheels
+  int max_slip_time = 500;
+  double max_slip_distance = 3;
+
+  int grip_timer = 0;
+  int slip_count = 0;
+  double slip_distance = 0;
+
+  void update();
+  void traction_task();
+};
+
+/**
+ * Traction control for the chassis.
+ */
+extern TractionControl traction;
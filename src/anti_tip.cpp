@@ -0,0 +1,81 @@
+#include "main.h"
+#include "anti_tip.hpp"
+
+AntiTip::AntiTip(Drive &drive) : drive(drive) {}
+
+void AntiTip::initialize() {
+  double pitch = drive.imu.get_pitch();
+  double roll = drive.imu.get_roll();
+  if (pitch != PROS_ERR_F) pitch_zero = last_pitch = pitch;
+  if (roll != PROS_ERR_F) roll_zero = roll;
+  pros::Task tip_control([this] { this->tip_task(); });
+}
+
+bool AntiTip::is_tipping() { return pitch_direction != 0 || rolled; }
+
+int AntiTip::get_tip_count() { return tip_count; }
+
+void AntiTip::set_thresholds(double pitch, double pitch_rate, double roll) {
+  pitch_threshold = fabs(pitch);
+  pitch_rate_threshold = fabs(pitch_rate);
+  roll_threshold = fabs(roll);
+}
+
+void AntiTip::set_max_change(double per_tick) { max_change = fabs(per_tick); }
+
+void AntiTip::set_pitch_reversed(bool toggle) { pitch_reversed = toggle; }
+
+void AntiTip::limit(double &left, double &right) {
+  double forward = (left + right) / 2.0;
+  double turn = (left - right) / 2.0;
+
+  // A long gap means this is a new motion, start from what it asked for
+  int now = pros::millis();
+  int elapsed = now - last_time;
+  last_time = now;
+  if (elapsed > 100) {
+    last_forward = forward;
+    last_turn = turn;
+    return;
+  }
+
+  // Speeding up forward or braking from reverse pitches the nose up, the opposite pitches it down
+  double max = max_change * elapsed / util::DELAY_TIME;
+  if (pitch_direction > 0 && forward - last_forward > max) forward = last_forward + max;
+  if (pitch_direction < 0 && forward - last_forward < -max) forward = last_forward - max;
+  if (rolled) turn = util::clip_num(turn, last_turn + max, last_turn - max);
+
+  last_forward = forward;
+  last_turn = turn;
+  left = forward + turn;
+  right = forward - turn;
+}
+
+void AntiTip::update() {
+  double pitch = drive.imu.get_pitch();
+  double roll = drive.imu.get_roll();
+  if (pitch == PROS_ERR_F || roll == PROS_ERR_F) return;
+
+  pitch = (pitch - pitch_zero) * (pitch_reversed ? -1 : 1);
+  double pitch_rate = (pitch - last_pitch) * 1000.0 / util::DELAY_TIME;
+  last_pitch = pitch;
+
+  bool was_tipping = is_tipping();
+  pitch_direction = 0;
+  if (pitch > pitch_threshold || pitch_rate > pitch_rate_threshold) pitch_direction = 1;
+  if (pitch < -pitch_threshold || pitch_rate < -pitch_rate_threshold) pitch_direction = -1;
+  rolled = fabs(roll - roll_zero) > roll_threshold;
+
+  // Less current means less torque to tip with, this also covers EZ-Template's motions
+  if (is_tipping() != was_tipping) {
+    if (is_tipping()) tip_count++;
+    currentArbiter.set_scale("drive", is_tipping() ? 0.5 : 1, "tip");
+  }
+}
+
+void AntiTip::tip_task() {
+  while (true) {
+    update();
+    pros::delay(util::DELAY_TIME);
+  }
+}
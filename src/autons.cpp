@@ -212,6 +212,7 @@ void tug(int attempts) {
     // If failsafed...
     if (chassis.interfered) {
       chassis.reset_drive_sensor();
+      driveHealth.tare();
       chassis.set_drive_pid(-2, 20);
       pros::delay(1000);
     }
@@ -225,10 +226,12 @@ void tug(int attempts) {
 // If there is no interference, robot will drive forward and turn 90 degrees.
 // If interfered, robot will drive forward and then attempt to drive backwards.
 void interfered_example() {
+  int interference_count = interference.get_count();
   chassis.set_drive_pid(24, DRIVE_SPEED, true);
   chassis.wait_drive();
 
-  if (chassis.interfered) {
+  // The detector catches pinning and pushing that never trips the mA timeout
+  if (chassis.interfered || interference.get_count() > interference_count) {
     tug(3);
     return;
   }
@@ -237,16 +240,35 @@ void interfered_example() {
   chassis.wait_drive();
 }
 
+///
+// Wall example
+///
+void wall_example() {
+  // The back wall is y = -70.2, and the back sensors face 180 degrees when square to it
+  field_wall back_wall = {false, -70.2, 180};
+
+  // Back up until the back sensors read 6 inches, then re-zero y from the wall
+  // This replaces guessing the distance with set_drive_pid and correcting afterwards
+  drive_to_wall(back_left_wall, 6, DRIVE_SPEED, &back_wall);
+
+  // Turn until both back sensors read the same, then re-zero heading and y from the wall
+  // The first parameters are the sensors, then inches between them
+  square_to_wall(back_left_wall, back_right_wall, 10, TURN_SPEED, &back_wall);
+
+  chassis.set_drive_pid(24, DRIVE_SPEED, true);
+  chassis.wait_drive();
+}
+
 // . . .
 // Make your own autonomous functions here!
 // . . .
 
 void fourpointfive() {
   // Intake First Ball
-  setIntake(100);
+  intakeController.intake(); // Stops on its own when the triball is seated
   chassis.set_drive_pid(15, 90);
   chassis.wait_drive();
-  pros::delay(200);
+  intakeController.wait_until_held(200);
   // Back Out to Match Loader
   chassis.set_drive_pid(-43.3, 45, true);
   chassis.wait_until(-20);
@@ -267,17 +289,16 @@ void fourpointfive() {
   chassis.set_swing_pid(ez::RIGHT_SWING, 90, SWING_SPEED);
   chassis.wait_drive();
   // Push into Goal and drive forward
-  chassis.set_drive_pid(-15.5, 127);
-  chassis.wait_drive();
+  push(-15.5, 127); // Exits as soon as the robot hits the goal
   chassis.set_drive_pid(11, DRIVE_SPEED);
   chassis.wait_drive();
   wingControl(false);
   chassis.set_turn_pid( 270,  TURN_SPEED);
   chassis.wait_drive();
   chassis.set_drive_pid(15, 127);
-  setIntake(-100);
+  intakeController.outtake();
   chassis.wait_drive();
-  pros::delay(200);
+  intakeController.wait_until_empty(200);
   chassis.set_drive_pid(-7, DRIVE_SPEED);
   chassis.wait_drive();
   chassis.set_turn_pid(90, TURN_SPEED);
@@ -304,10 +325,10 @@ void fourpointfive() {
 
 void fourpointfivefixed() {
   // Intake First Ball
-  setIntake(100);
+  intakeController.intake(); // Stops on its own when the triball is seated
   chassis.set_drive_pid(12, DRIVE_SPEED);
   chassis.wait_drive();
-  pros::delay(200);
+  intakeController.wait_until_held(200);
   // Back Out to Match Loader
   chassis.set_drive_pid(-38, 45, true);
   chassis.wait_until(-10);
@@ -330,8 +351,7 @@ void fourpointfivefixed() {
   chassis.set_turn_pid(90, TURN_SPEED);
   chassis.wait_drive();
   setIntake(-100);
-  chassis.set_drive_pid(20, 127);
-  chassis.wait_drive();
+  push(20, 127); // Exits as soon as the robot hits the goal
   chassis.set_drive_pid(-16, DRIVE_SPEED);
   chassis.wait_drive();
   chassis.set_turn_pid(23, TURN_SPEED);
@@ -403,9 +423,7 @@ void allianceStealD(){
 
 void awpStealD(){
   setIntake(100);
-  blockerControl(true);
-pros::delay(50);
-blockerControl(false);
+  blockerActuation.pulse(50);
   chassis.set_drive_pid(51, DRIVE_SPEED, true);
   chassis.wait_drive();
   chassis.set_turn_pid(-90, TURN_SPEED); 
@@ -473,10 +491,9 @@ chassis.wait_drive();
 }
 
 void skills(){
-    wingControl(true);
-    pros::delay(500);
-    wingControl(false);
-    chassis.wait_drive();
+  odom.set_pose_from_gps(); // Long lanes drift, let the GPS correct the heading when one is plugged in
+  wingActuation.pulse(500);
+  chassis.wait_drive();
   setIntake(-100);
   chassis.set_turn_pid(-45,TURN_SPEED);
   chassis.wait_drive();
@@ -531,10 +548,10 @@ void skills(){
 
 void threeballAWP() {
   // Intake First Ball
-  setIntake(100);
+  intakeController.intake(); // Stops on its own when the triball is seated
   chassis.set_drive_pid(15, 90);
   chassis.wait_drive();
-  pros::delay(200);
+  intakeController.wait_until_held(200);
   // Back Out to Match Loader
   chassis.set_drive_pid(-43, 45, true);
   chassis.wait_until(-10);
@@ -555,17 +572,16 @@ void threeballAWP() {
   chassis.set_swing_pid(ez::LEFT_SWING, -90, SWING_SPEED);
   chassis.wait_drive();
   // Push into Goal and drive forward
-  chassis.set_drive_pid(-15.5, 127);
-  chassis.wait_drive();
+  push(-15.5, 127); // Exits as soon as the robot hits the goal
   chassis.set_drive_pid(11, DRIVE_SPEED);
   chassis.wait_drive();
   wingControl(false);
   chassis.set_turn_pid( 90,  TURN_SPEED);
   chassis.wait_drive();
   chassis.set_drive_pid(15, 127);
-  setIntake(-100);
+  intakeController.outtake();
   chassis.wait_drive();
-  pros::delay(200);
+  intakeController.wait_until_empty(200);
   chassis.set_drive_pid(-7, DRIVE_SPEED);
   chassis.wait_drive();
   chassis.set_turn_pid(-90, TURN_SPEED);
@@ -585,19 +601,15 @@ chassis.set_drive_pid(-38, DRIVE_SPEED);
 }
 
 void sixballauton() {
-blockerControl(true);
-pros::delay(50);
-blockerControl(false);
-wingControl(true);
-pros::delay(350);
-wingControl(false);
+blockerActuation.pulse(50);
+wingActuation.pulse(350);
 //pointing at middle ball
  chassis.set_drive_pid(64,DRIVE_SPEED);
  chassis.wait_drive();
  chassis.set_turn_pid(-45, SWING_SPEED);
  setIntake(100);
  chassis.wait_drive();
- chassis.set_angle(0);
+ imus.set_angle(0);
  chassis.set_drive_pid(3, 127);
  chassis.wait_drive();
  //reverse to smack both ball in 
@@ -651,19 +663,15 @@ chassis.set_drive_pid(20, 127);
 }
 
 void threeballsave(){
-  blockerControl(true);
-pros::delay(50);
-blockerControl(false);
-wingControl(true);
-pros::delay(350);
-wingControl(false);
+  blockerActuation.pulse(50);
+wingActuation.pulse(350);
 //pointing at middle ball
  chassis.set_drive_pid(64,DRIVE_SPEED);
  chassis.wait_drive();
  chassis.set_turn_pid(-45, SWING_SPEED);
  setIntake(100);
  chassis.wait_drive();
- chassis.set_angle(0);
+ imus.set_angle(0);
  chassis.set_drive_pid(3, 127);
  chassis.wait_drive();
  //reverse to smack both ball in 
@@ -698,9 +706,7 @@ wingControl(false);
 
 void mactar2Ball(){
    setIntake(100);
-  blockerControl(true);
-pros::delay(50);
-blockerControl(false);
+  blockerActuation.pulse(50);
   chassis.set_drive_pid(51, DRIVE_SPEED, true);
   chassis.wait_drive();
   chassis.set_turn_pid(-90, TURN_SPEED); 
@@ -768,9 +774,7 @@ chassis.wait_drive();
 
 void DangerousDefensiveAWP(){
 
-  wingControl(true);
-  pros::delay(500);
-  wingControl(false);
+  wingActuation.pulse(500);
   chassis.set_drive_pid(43.5, 127);
   chassis.wait_drive();
   chassis.set_turn_pid(90, DRIVE_SPEED);
@@ -812,9 +816,7 @@ void DangerousDefensiveAWP(){
 
 void SafedefensiveAWP(){
   setIntake(100);
-    blockerControl(true);
-    pros::delay(200);
-    blockerControl(false);
+    blockerActuation.pulse(200);
   chassis.wait_drive();
   chassis.set_turn_pid(-45,TURN_SPEED);
   chassis.wait_drive();
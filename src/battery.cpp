@@ -0,0 +1,44 @@
+#include "main.h"
+#include "battery.hpp"
+
+VoltageCompensator::VoltageCompensator(int nominal) : nominal(nominal) {}
+
+void VoltageCompensator::initialize() {
+  pros::Task battery_control([this] { this->battery_task(); });
+}
+
+void VoltageCompensator::battery_task() {
+  while (true) {
+    std::int32_t reading = pros::battery::get_voltage();
+    if (reading != PROS_ERR && reading > 0) {
+      // Filtered over about a second so a motor starting up doesn't swing the gain
+      voltage = voltage == 0 ? reading : voltage + (reading - voltage) * 0.01;
+      if (lowest == 0 || voltage < lowest) lowest = voltage;
+      if (get_gain() > highest_gain) highest_gain = get_gain();
+    }
+    pros::delay(util::DELAY_TIME);
+  }
+}
+
+double VoltageCompensator::get_voltage() { return voltage; }
+
+double VoltageCompensator::get_gain() {
+  if (!enabled || voltage <= 0) return 1;
+  // Don't chase a reading that's clearly wrong
+  return util::clip_num(nominal / voltage, 1.3, 0.8);
+}
+
+double VoltageCompensator::compensate(double command, double max) { return util::clip_num(command * get_gain(), max, -max); }
+
+void VoltageCompensator::set_enabled(bool toggle) { enabled = toggle; }
+
+void VoltageCompensator::set_nominal(int mV) { nominal = mV; }
+
+void VoltageCompensator::print_report() {
+  printf("\nBattery %.2f V, gain %.3f, lowest %.2f V, highest gain %.3f\n", voltage / 1000.0, get_gain(), lowest / 1000.0, highest_gain);
+}
+
+void compensated_tank(double left, double right) {
+  antiTip.limit(left, right);
+  chassis.set_tank(voltageComp.compensate(left, 127), voltageComp.compensate(right, 127));
+}
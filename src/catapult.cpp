@@ -0,0 +1,202 @@
+#include "main.h"
+#include "catapult.hpp"
+
+CatapultController::CatapultController(pros::Motor &motor, double cycle_degrees, double reload_position)
+    : motor(motor), cycle_degrees(cycle_degrees), reload_position(reload_position) {}
+
+void CatapultController::initialize() {
+  motor.set_encoder_units(pros::E_MOTOR_ENCODER_DEGREES);
+  motor.set_brake_mode(pros::E_MOTOR_BRAKE_HOLD);
+  motor.tare_position();
+  last_cycle = 0;
+  pros::Task catapult_control([this] { this->catapult_task(); });
+}
+
+void CatapultController::fire(int shots) {
+  synced = false;
+  target_shots = shots;
+  shots_this_run = 0;
+  stop_requested = false;
+  reloading = false;
+  // The first shot of a run starts from rest, so don't count it as a cycle
+  last_shot_time = 0;
+  rest_time = 0;
+  running = true;
+}
+
+void CatapultController::match_load(int shots) {
+  fire(shots);
+  if (!load_sensor_connected()) {
+    if (load_sensor) printf("Catapult load sensor not reporting, firing without it\n");
+    return;
+  }
+  synced = true;
+  sensor_error_timer = 0;
+  firing = false;
+  load_timer = 0;
+
+  // Wait loaded, staying put if it's already past the reload position
+  reload_target = get_cycle() * cycle_degrees + reload_position;
+  if (motor.get_position() > reload_target) reload_target = motor.get_position();
+  motor.move_absolute(reload_target, 100);
+}
+
+void CatapultController::set_load_sensor(int port, int p_load_distance, int p_load_delay) {
+  load_sensor = new pros::Distance(port);
+  load_distance = p_load_distance;
+  load_delay = p_load_delay;
+}
+
+bool CatapultController::load_sensor_connected() { return load_sensor && load_sensor->get() != PROS_ERR; }
+
+bool CatapultController::triball_loaded() {
+  if (!load_sensor) return false;
+  int32_t distance = load_sensor->get();
+  return distance != PROS_ERR && distance > 0 && distance < load_distance;
+}
+
+void CatapultController::stop() {
+  if (running) stop_requested = true;
+}
+
+bool CatapultController::is_running() { return running; }
+
+bool CatapultController::wait_until_done(int timeout) {
+  for (int i = 0; i < timeout; i += util::DELAY_TIME) {
+    if (!running) return true;
+    pros::delay(util::DELAY_TIME);
+  }
+  return !running;
+}
+
+void CatapultController::set_reload_position(double degrees) { reload_position = degrees; }
+
+void CatapultController::set_duty_cycle(double p_duty) { duty = util::clip_num(p_duty, 1, 0.1); }
+
+int CatapultController::get_shot_count() { return shot_count; }
+
+int CatapultController::get_last_cycle_time() { return last_cycle_time; }
+
+double CatapultController::get_average_cycle_time() { return cycle_count == 0 ? 0 : cycle_time_sum / (double)cycle_count; }
+
+double CatapultController::get_shots_per_minute() {
+  double average = get_average_cycle_time();
+  return average == 0 ? 0 : 60000.0 / average;
+}
+
+void CatapultController::reset_stats() {
+  shot_count = 0;
+  last_cycle_time = 0;
+  cycle_time_sum = 0;
+  cycle_count = 0;
+  for (int i = 0; i < HISTOGRAM_BUCKETS; i++) histogram[i] = 0;
+}
+
+void CatapultController::print_report() {
+  printf("Catapult: %i shots, %.0f ms average cycle, %.1f shots per minute\n", shot_count, get_average_cycle_time(), get_shots_per_minute());
+  for (int i = 0; i < HISTOGRAM_BUCKETS; i++) {
+    if (i == HISTOGRAM_BUCKETS - 1)
+      printf("%5i+     ms | ", i * 100);
+    else
+      printf("%5i-%4i ms | ", i * 100, i * 100 + 99);
+    for (int j = 0; j < histogram[i]; j++) printf("#");
+    printf(" %i\n", histogram[i]);
+  }
+}
+
+int CatapultController::get_cycle() { return (int)floor(motor.get_position() / cycle_degrees); }
+
+void CatapultController::record_shot() {
+  int now = pros::millis();
+  if (last_shot_time != 0) {
+    last_cycle_time = now - last_shot_time - rest_time;
+    cycle_time_sum += last_cycle_time;
+    cycle_count++;
+    int bucket = last_cycle_time / 100;
+    histogram[bucket < HISTOGRAM_BUCKETS ? bucket : HISTOGRAM_BUCKETS - 1]++;
+  }
+  last_shot_time = now;
+  rest_time = 0;
+  shot_count++;
+  shots_this_run++;
+}
+
+void CatapultController::update() {
+  int cycle = get_cycle();
+  bool released = cycle > last_cycle;
+  for (int i = last_cycle; i < cycle; i++) record_shot();
+  last_cycle = cycle;
+
+  // A load sensor that drops out mid match load would wait forever, so carry on firing without it
+  if (running && synced) {
+    sensor_error_timer = load_sensor_connected() ? 0 : sensor_error_timer + util::DELAY_TIME;
+    if (sensor_error_timer >= 100) {
+      printf("Catapult load sensor lost, firing without it\n");
+      synced = false;
+      firing = false;
+    }
+  }
+
+  if (running && synced && !reloading) {
+    bool done = (target_shots > 0 && shots_this_run >= target_shots) || stop_requested;
+    if (firing) {
+      // Spin through the release, then go back to waiting loaded
+      motor.move_voltage(voltageComp.compensate(FIRE_VOLTAGE, FIRE_VOLTAGE));
+      if (cycle > fire_cycle) {
+        firing = false;
+        reload_target = cycle * cycle_degrees + reload_position;
+        motor.move_absolute(reload_target, 100);
+      }
+    } else if (done) {
+      reloading = true;
+    } else {
+      // Only fire from the reload position, with a triball that has settled on the catapult
+      bool loaded = fabs(motor.get_position() - reload_target) < 5;
+      load_timer = loaded && triball_loaded() ? load_timer + util::DELAY_TIME : 0;
+      if (load_timer >= load_delay) {
+        load_timer = 0;
+        fire_cycle = cycle;
+        firing = true;
+      }
+    }
+  } else if (running && !reloading) {
+    bool done = (target_shots > 0 && shots_this_run >= target_shots) || stop_requested;
+
+    // Below full duty, wait loaded after each release for long enough to bring the average down
+    if (released && duty < 1 && !done) {
+      int cycle_time = last_cycle_time > 0 ? last_cycle_time : 500;
+      rest_timer = cycle_time * (1 - duty) / duty;
+      reload_target = cycle * cycle_degrees + reload_position;
+      motor.move_absolute(reload_target, 100);
+    }
+    if (rest_timer > 0 && !done) {
+      rest_timer -= util::DELAY_TIME;
+      // The rest doesn't count toward cycle time
+      rest_time += util::DELAY_TIME;
+      return;
+    }
+    rest_timer = 0;
+
+    motor.move_voltage(voltageComp.compensate(FIRE_VOLTAGE, FIRE_VOLTAGE));
+    if (done) {
+      reloading = true;
+      reload_target = cycle * cycle_degrees + reload_position;
+      // Already past the reload position means it's loaded, stop right here
+      if (motor.get_position() > reload_target) reload_target = motor.get_position();
+      motor.move_absolute(reload_target, 100);
+    }
+  }
+
+  if (reloading && fabs(motor.get_position() - reload_target) < 5) {
+    reloading = false;
+    stop_requested = false;
+    running = false;
+  }
+}
+
+void CatapultController::catapult_task() {
+  while (true) {
+    update();
+    pros::delay(util::DELAY_TIME);
+  }
+}
@@ -0,0 +1,109 @@
+#include "main.h"
+#include "current_arbiter.hpp"
+
+CurrentArbiter::CurrentArbiter(int budget) : budget(budget) {}
+
+void CurrentArbiter::add(std::string name, int motors, int min_mA, int priority, std::function<void(int)> limit, std::function<bool()> active) {
+  group added;
+  added.name = name;
+  added.motors = motors < 1 ? 1 : motors;
+  added.min_mA = util::clip_num(min_mA, MAX_MA, 0);
+  added.priority = priority;
+  added.limit = limit;
+  added.active = active;
+
+  mutex.take();
+  groups.push_back(added);
+  mutex.give();
+}
+
+void CurrentArbiter::initialize() {
+  pros::Task current_control([this] {
+    while (true) {
+      this->update();
+      pros::delay(50);
+    }
+  });
+}
+
+CurrentArbiter::group *CurrentArbiter::find(std::string name) {
+  for (auto &g : groups)
+    if (g.name == name) return &g;
+  return nullptr;
+}
+
+void CurrentArbiter::set_focus(std::string name) {
+  mutex.take();
+  focus = name;
+  mutex.give();
+  update();
+}
+
+void CurrentArbiter::set_scale(std::string name, double scale, std::string reason) {
+  mutex.take();
+  group *g = find(name);
+  if (g) {
+    g->scales[reason] = util::clip_num(scale, 1, 0);
+    g->scale = 1;
+    for (auto &s : g->scales) g->scale *= s.second;
+  }
+  mutex.give();
+  update();
+}
+
+int CurrentArbiter::get_limit(std::string name) {
+  mutex.take();
+  group *g = find(name);
+  int limit = g ? g->allocated : -1;
+  mutex.give();
+  return limit;
+}
+
+void CurrentArbiter::update() {
+  mutex.take();
+
+  // Everyone gets their minimum first
+  int remaining = budget;
+  std::vector<int> totals;
+  std::vector<group *> order;
+  for (auto &g : groups) {
+    // A scaled down group can end up below its minimum
+    int base = std::min(g.min_mA, (int)(MAX_MA * g.scale)) * g.motors;
+    totals.push_back(base);
+    remaining -= base;
+    if (!g.active || g.active()) order.push_back(&g);
+  }
+
+  // Then the focused group, then by priority
+  std::stable_sort(order.begin(), order.end(), [this](group *a, group *b) {
+    bool a_focus = a->name == focus, b_focus = b->name == focus;
+    if (a_focus != b_focus) return a_focus;
+    return a->priority > b->priority;
+  });
+  for (auto g : order) {
+    if (remaining <= 0) break;
+    int index = g - &groups[0];
+    int wanted = (int)(MAX_MA * g->scale) * g->motors - totals[index];
+    int extra = wanted < remaining ? wanted : remaining;
+    if (extra <= 0) continue;
+    totals[index] += extra;
+    remaining -= extra;
+  }
+
+  // Only write limits that changed
+  for (int i = 0; i < (int)groups.size(); i++) {
+    int per_motor = totals[i] / groups[i].motors;
+    if (abs(per_motor - groups[i].allocated) < 50) continue;
+    groups[i].allocated = per_motor;
+    if (groups[i].limit) groups[i].limit(per_motor);
+  }
+
+  mutex.give();
+}
+
+void CurrentArbiter::print_report() {
+  mutex.take();
+  printf("\nCurrent, %i mA budget\n", budget);
+  for (auto &g : groups) printf("%-8s %i motors at %i mA, scale %.2f\n", g.name.c_str(), g.motors, g.allocated, g.scale);
+  mutex.give();
+}
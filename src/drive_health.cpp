@@ -0,0 +1,175 @@
+#include "main.h"
+#include "drive_health.hpp"
+
+static const char *health_to_string(motor_health health) {
+  switch (health) {
+    case MOTOR_OK:
+      return "ok";
+    case MOTOR_DISCONNECTED:
+      return "disconnected";
+    case MOTOR_FAULTED:
+      return "faulted";
+    case MOTOR_GLITCHING:
+      return "glitching";
+  }
+  return "";
+}
+
+DriveHealth::DriveHealth(Drive &drive) : drive(drive) {
+  left.motors = &drive.left_motors;
+  right.motors = &drive.right_motors;
+  for (auto &device : drive.left_motors) left.health.push_back({device.get_port()});
+  for (auto &device : drive.right_motors) right.health.push_back({device.get_port()});
+}
+
+void DriveHealth::initialize() {
+  tare();
+  pros::Task health_control([this] { this->health_task(); });
+}
+
+void DriveHealth::tare() {
+  mutex.take();
+  for (auto &device : drive.left_motors) device.tare_position();
+  for (auto &device : drive.right_motors) device.tare_position();
+  // Everything moved to 0, so start counting changes from there
+  for (auto &m : left.health) m.last_position = 0;
+  for (auto &m : right.health) m.last_position = 0;
+  mutex.give();
+}
+
+double DriveHealth::get_left() { return left.position; }
+
+double DriveHealth::get_right() { return right.position; }
+
+motor_health DriveHealth::get_health(int port) {
+  for (auto &m : left.health)
+    if (m.port == abs(port)) return m.health;
+  for (auto &m : right.health)
+    if (m.port == abs(port)) return m.health;
+  return MOTOR_DISCONNECTED;
+}
+
+int DriveHealth::get_fault_count() {
+  int count = 0;
+  for (auto &m : left.health) count += m.health != MOTOR_OK;
+  for (auto &m : right.health) count += m.health != MOTOR_OK;
+  return count;
+}
+
+int DriveHealth::get_failover_count() { return failover_count; }
+
+motor_health DriveHealth::check(pros::Motor &device, motor &m) {
+  if (device.get_position() == PROS_ERR_F) return MOTOR_DISCONNECTED;
+
+  // A motor that can't talk for a few ticks is as good as unplugged
+  std::uint32_t flags = device.get_flags();
+  m.busy_timer = flags != PROS_ERR && (flags & pros::E_MOTOR_FLAGS_BUSY) ? m.busy_timer + util::DELAY_TIME : 0;
+  if (m.busy_timer >= 50) return MOTOR_DISCONNECTED;
+
+  std::uint32_t faults = device.get_faults();
+  if (faults != PROS_ERR && (faults & (pros::E_MOTOR_FAULT_DRIVER_FAULT | pros::E_MOTOR_FAULT_DRV_OVER_CURRENT))) return MOTOR_FAULTED;
+
+  // Disagreeing now and then is backlash, doing it a lot is a bad encoder
+  if (m.glitches >= 5) return MOTOR_GLITCHING;
+  return MOTOR_OK;
+}
+
+void DriveHealth::update_side(side &s, std::string name) {
+  std::vector<double> deltas;
+  std::vector<int> indexes;
+  for (int i = 0; i < (int)s.motors->size(); i++) {
+    pros::Motor &device = (*s.motors)[i];
+    // Failover can reorder the Drive's vector, so match by port
+    motor *m = nullptr;
+    for (auto &h : s.health)
+      if (h.port == device.get_port()) m = &h;
+    if (!m) continue;
+
+    // Coming back needs half a second of being fine
+    motor_health health = check(device, *m);
+    m->healthy_timer = health == MOTOR_OK ? m->healthy_timer + util::DELAY_TIME : 0;
+    if (health != m->health && (health != MOTOR_OK || m->healthy_timer >= 500)) {
+      printf("Drive %s port %i %s\n", name.c_str(), m->port, health_to_string(health));
+      m->health = health;
+      m->started = false;
+    }
+
+    m->glitch_timer += util::DELAY_TIME;
+    if (m->glitch_timer >= 1000) {
+      m->glitch_timer = 0;
+      m->glitches = 0;
+    }
+
+    double position = device.get_position();
+    if (position == PROS_ERR_F) continue;
+    if (m->health == MOTOR_OK && m->started) {
+      deltas.push_back(position - m->last_position);
+      indexes.push_back(m - &s.health[0]);
+    }
+    m->last_position = position;
+    m->started = true;
+  }
+  if (deltas.empty()) return;
+
+  // Median of the changes, two motors that disagree trust whichever is closer to last tick
+  std::vector<double> sorted = deltas;
+  std::sort(sorted.begin(), sorted.end());
+  double middle;
+  if (sorted.size() == 2 && fabs(sorted[1] - sorted[0]) > OUTLIER_TICKS)
+    middle = fabs(sorted[0] - s.last_delta) < fabs(sorted[1] - s.last_delta) ? sorted[0] : sorted[1];
+  else
+    middle = sorted.size() % 2 == 1 ? sorted[sorted.size() / 2] : (sorted[sorted.size() / 2 - 1] + sorted[sorted.size() / 2]) / 2.0;
+
+  double sum = 0;
+  int count = 0;
+  for (int i = 0; i < (int)deltas.size(); i++) {
+    if (fabs(deltas[i] - middle) > OUTLIER_TICKS + fabs(middle) * 0.2) {
+      s.health[indexes[i]].glitches++;
+      continue;
+    }
+    sum += deltas[i];
+    count++;
+  }
+  s.last_delta = count == 0 ? middle : sum / count;
+  s.position += s.last_delta;
+}
+
+void DriveHealth::failover(side &s, std::string name) {
+  std::vector<pros::Motor> &motors = *s.motors;
+  if (get_health(motors[0].get_port()) == MOTOR_OK) return;
+
+  for (int i = 1; i < (int)motors.size(); i++) {
+    if (get_health(motors[i].get_port()) != MOTOR_OK) continue;
+
+    // Swap so the healthy motor is first and every motor is still driven
+    pros::Motor sensored = motors[0];
+    pros::Motor healthy = motors[i];
+    motors[0].~Motor();
+    new (&motors[0]) pros::Motor(healthy);
+    motors[i].~Motor();
+    new (&motors[i]) pros::Motor(sensored);
+
+    failover_count++;
+    printf("Drive %s sensored motor moved from port %i to port %i\n", name.c_str(), sensored.get_port(), healthy.get_port());
+    return;
+  }
+}
+
+void DriveHealth::print_report() {
+  printf("\nDrive motors, %i failovers\n", failover_count);
+  for (auto &m : left.health) printf("left  port %2i %s\n", m.port, health_to_string(m.health));
+  for (auto &m : right.health) printf("right port %2i %s\n", m.port, health_to_string(m.health));
+}
+
+void DriveHealth::health_task() {
+  while (true) {
+    mutex.take();
+    update_side(left, "left");
+    update_side(right, "right");
+    // Swapped in any mode, a dead sensored motor mid auton would ruin every motion after it
+    failover(left, "left");
+    failover(right, "right");
+    mutex.give();
+    pros::delay(util::DELAY_TIME);
+  }
+}
@@ -0,0 +1,116 @@
+#include "main.h"
+#include "drive_sensors.hpp"
+
+AlphaBetaFilter::AlphaBetaFilter(double alpha, double beta) : alpha(alpha), beta(beta) {}
+
+void AlphaBetaFilter::reset(double p_position) {
+  position = p_position;
+  velocity = 0;
+}
+
+void AlphaBetaFilter::update(double measurement, double dt) {
+  if (dt <= 0) return;
+  position += velocity * dt;
+  double miss = measurement - position;
+  position += alpha * miss;
+  velocity += beta * miss / dt;
+}
+
+DriveSensors::DriveSensors(Drive &drive, ImuGroup &imus) : drive(drive), imus(imus) {}
+
+void DriveSensors::reset() {
+  left = side();
+  right = side();
+  heading = imus.get_rotation();
+  heading_time = pros::millis();
+  heading_filter.reset(heading);
+  distance_filter.reset(0);
+  distance_time = 0;
+  stale = false;
+  reads = 0;
+  stale_reads = 0;
+  samples = 0;
+  interval_sum = 0;
+}
+
+bool DriveSensors::read(pros::Motor &motor, side &s) {
+  std::uint32_t time = 0;
+  std::int32_t position = motor.get_raw_position(&time);
+  reads++;
+  // Raw counts ignore the reversed flag
+  if (position != PROS_ERR && motor.is_reversed()) position = -position;
+  if (position == PROS_ERR || (s.started && time == s.time)) {
+    stale_reads++;
+    return false;
+  }
+
+  if (!s.started) {
+    s.started = true;
+    s.start = position;
+  } else if (motor.get_port() != s.port) {
+    // DriveHealth moved the sensored motor, carry the distance over instead of jumping
+    s.start += position - s.position;
+  } else if (time > s.time) {
+    s.velocity = (position - s.position) / (double)(time - s.time) * 1000.0;
+    samples++;
+    interval_sum += time - s.time;
+  }
+  s.port = motor.get_port();
+  s.position = position;
+  s.time = time;
+  return true;
+}
+
+void DriveSensors::update() {
+  // Raw counts are in the same units EZ-Template's sensors use, just never tared
+  bool fresh_left = read(drive.left_motors[0], left);
+  bool fresh_right = read(drive.right_motors[0], right);
+  stale = !fresh_left && !fresh_right;
+
+  // Filter on the time of the newest sample, not the time of this loop
+  if (!stale) {
+    std::uint32_t time = left.time > right.time ? left.time : right.time;
+    if (distance_time == 0)
+      distance_filter.reset(get_distance());
+    else
+      distance_filter.update(get_distance(), (time - distance_time) / 1000.0);
+    distance_time = time;
+  }
+
+  // Only filter when the IMU has a new reading, a reading that holds still for a while is a stopped robot
+  double reading = imus.get_rotation();
+  int now = pros::millis();
+  if (reading != heading || now - heading_time >= 2 * util::DELAY_TIME) {
+    heading_filter.update(reading, (now - heading_time) / 1000.0);
+    heading = reading;
+    heading_time = now;
+  }
+}
+
+void DriveSensors::set_filter_constants(double alpha, double beta) {
+  distance_filter.alpha = heading_filter.alpha = util::clip_num(alpha, 1, 0);
+  distance_filter.beta = heading_filter.beta = util::clip_num(beta, 1, 0);
+}
+
+double DriveSensors::get_distance() {
+  double ticks = ((left.position - left.start) + (right.position - right.start)) / 2.0;
+  return ticks / drive.get_tick_per_inch();
+}
+
+double DriveSensors::get_velocity() { return distance_filter.velocity; }
+
+double DriveSensors::get_raw_velocity() { return (left.velocity + right.velocity) / 2.0 / drive.get_tick_per_inch(); }
+
+double DriveSensors::get_heading() { return heading; }
+
+double DriveSensors::get_heading_rate() { return heading_filter.velocity; }
+
+bool DriveSensors::is_stale() { return stale; }
+
+double DriveSensors::get_stale_rate() { return reads == 0 ? 0 : stale_reads / (double)reads; }
+
+double DriveSensors::get_sample_interval() { return samples == 0 ? 0 : interval_sum / (double)samples; }
+
+void DriveSensors::print_report() {
+  printf("\nDrive sensors, %i reads, %.0f%% stale, %.1f ms between samples\n", reads, get_stale_rate() * 100.0, get_sample_interval());
+}
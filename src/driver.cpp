@@ -0,0 +1,209 @@
+#include "main.h"
+#include "driver.hpp"
+
+AccelLimiter::AccelLimiter(double up, double down, double jerk) : up(up), down(down), jerk(jerk) {}
+
+void AccelLimiter::set_limits(double p_up, double p_down, double p_jerk) {
+  up = fabs(p_up);
+  down = fabs(p_down);
+  jerk = fabs(p_jerk);
+}
+
+void AccelLimiter::reset() {
+  output = 0;
+  rate = 0;
+  last_time = 0;
+}
+
+double AccelLimiter::step(double target) {
+  // Scale the limits to the real time between calls
+  int now = pros::millis();
+  double ticks = last_time == 0 ? 1 : (now - last_time) / (double)util::DELAY_TIME;
+  // Not called in a while, so whatever was last output isn't what the motors are doing, ramp up from rest
+  if (ticks > 10) {
+    reset();
+    ticks = 1;
+  }
+  last_time = now;
+
+  bool slowing = (output > 0 && target < output) || (output < 0 && target > output);
+  double max = (slowing ? down : up) * ticks;
+  double change = target - output;
+  if (max > 0) change = util::clip_num(change, max, -max);
+  // Jerk ramps the rate up when speeding up, slowing down is never held back
+  if (jerk > 0 && !slowing) change = util::clip_num(change, fabs(rate) + jerk * ticks, -fabs(rate) - jerk * ticks);
+
+  double next = output + change;
+  // Don't ramp past the target, and stop at 0 before speeding up the other way
+  if ((change > 0 && next > target) || (change < 0 && next < target)) next = target;
+  if (slowing && util::sgn(next) != util::sgn(output) && next != 0) next = 0;
+
+  rate = next - output;
+  output = next;
+  return output;
+}
+
+static AccelLimiter left_limiter;
+static AccelLimiter right_limiter;
+static int peak_mA = 0;
+
+void set_driver_acceleration(double up, double down, double jerk) {
+  left_limiter.set_limits(up, down, jerk);
+  right_limiter.set_limits(up, down, jerk);
+}
+
+void driver_print_report() { printf("\nDriver control, peak drive current %i mA\n", peak_mA); }
+
+// Heading assist
+static bool heading_assist = true;
+static double assist_tolerance = 8;
+static bool assisting = false;
+
+void set_heading_assist(bool toggle, double tolerance) {
+  heading_assist = toggle;
+  assist_tolerance = fabs(tolerance);
+}
+
+// Holds the heading from when the sticks were first equal, until the driver turns
+static void assist(double stick_left, double stick_right, double &left, double &right) {
+  bool straight = fabs(stick_left - stick_right) < assist_tolerance && fabs(stick_left + stick_right) / 2.0 > chassis.JOYSTICK_THRESHOLD;
+  if (!heading_assist || !straight) {
+    assisting = false;
+    return;
+  }
+
+  if (!assisting) {
+    assisting = true;
+    chassis.headingPID.reset_variables();
+    chassis.headingPID.set_target(imus.get_rotation());
+  }
+  double drive = (left + right) / 2.0;
+  double gyro_out = chassis.headingPID.compute(imus.get_rotation());
+  left = util::clip_num(drive + gyro_out, 127, -127);
+  right = util::clip_num(drive - gyro_out, 127, -127);
+}
+
+// Position hold
+static pros::controller_digital_e_t hold_button = pros::E_CONTROLLER_DIGITAL_X;
+static RatePID hold_pid(15, 0.5, 60, 2);
+static RatePID hold_heading_pid(4, 0, 20);
+static double hold_ks = 10;
+static bool holding = false;
+static double hold_distance = 0;
+static double most_pushed = 0;
+static double most_turned = 0;
+
+void set_position_hold_button(pros::controller_digital_e_t button) { hold_button = button; }
+
+void set_position_hold_constants(double kp, double ki, double kd, double ks, double heading_kp, double heading_kd) {
+  hold_pid.pid.set_constants(kp, ki, kd, hold_pid.pid.constants.start_i);
+  hold_heading_pid.pid.set_constants(heading_kp, 0, heading_kd);
+  hold_ks = fabs(ks);
+}
+
+bool is_holding_position() { return holding; }
+
+// Averaged distance of both sides in inches
+static double drive_distance() { return (driveHealth.get_left() + driveHealth.get_right()) / 2.0 / chassis.get_tick_per_inch(); }
+
+static void start_hold() {
+  holding = true;
+  assisting = false;
+  hold_distance = drive_distance();
+  hold_pid.set_target(0);
+  hold_heading_pid.set_target(imus.get_rotation());
+  most_pushed = most_turned = 0;
+  left_limiter.reset();
+  right_limiter.reset();
+  currentArbiter.set_focus("drive");
+  master.rumble(".");
+}
+
+static void release_hold() {
+  holding = false;
+  // The limiters weren't stepped while holding, start the driver from rest
+  left_limiter.reset();
+  right_limiter.reset();
+  currentArbiter.set_focus("");
+  printf("Position hold released, pushed up to %.2f in and %.1f deg\n", most_pushed, most_turned);
+}
+
+static void update_hold() {
+  double pushed = drive_distance() - hold_distance;
+  double turned = imus.get_rotation() - hold_heading_pid.pid.get_target();
+  if (fabs(pushed) > most_pushed) most_pushed = fabs(pushed);
+  if (fabs(turned) > most_turned) most_turned = fabs(turned);
+
+  // Friction holds the robot until the push is big enough to move it, so always push back a little
+  double drive_out = hold_pid.compute(pushed);
+  if (fabs(pushed) > 0.1) drive_out += util::sgn(-pushed) * hold_ks;
+  double turn_out = hold_heading_pid.compute(imus.get_rotation());
+
+  // Pushing back hard can tip the robot as easily as driving, so this goes through anti-tip too
+  double left = util::clip_num(drive_out + turn_out, 127, -127);
+  double right = util::clip_num(drive_out - turn_out, 127, -127);
+  compensated_tank(left, right);
+}
+
+// Any stick lets go of position hold this tick.  Returns true while holding
+static bool position_hold(bool sticks) {
+  if (holding && sticks) release_hold();
+  if (!holding && !sticks && master.get_digital_new_press(hold_button)) start_hold();
+  if (holding) update_hold();
+  return holding;
+}
+
+// Curved stick output through the limiters, heading assist, anti-tip and battery compensation
+static void driver_output(double left, double right) {
+  double curved_left = left, curved_right = right;
+  left = left_limiter.step(left);
+  right = right_limiter.step(right);
+  assist(curved_left, curved_right, left, right);
+  antiTip.limit(left, right);
+
+  chassis.joy_thresh_opcontrol(voltageComp.compensate(left, 127), voltageComp.compensate(right, 127));
+
+  // Shows whether the limiter is keeping current down
+  int mA = (chassis.left_mA() + chassis.right_mA()) / 2;
+  if (mA > peak_mA) peak_mA = mA;
+}
+
+void driver_tank() {
+  // Drive::is_tank is private and only Drive::tank() sets it, without it the
+  // curve buttons and display treat the drive as arcade.  Its output is
+  // overwritten below in the same tick
+  static bool tank_set = false;
+  if (!tank_set) {
+    chassis.tank();
+    tank_set = true;
+  }
+  chassis.reset_drive_sensors_opcontrol();
+  chassis.modify_curve_with_controller();
+
+  int left_stick = master.get_analog(ANALOG_LEFT_Y);
+  int right_stick = master.get_analog(ANALOG_RIGHT_Y);
+  if (position_hold(abs(left_stick) > chassis.JOYSTICK_THRESHOLD || abs(right_stick) > chassis.JOYSTICK_THRESHOLD)) return;
+
+  // Tank puts both sticks through the left curve
+  driver_output(chassis.left_curve_function(left_stick), chassis.left_curve_function(right_stick));
+}
+
+void driver_arcade(ez::e_type stick_type) {
+  // Same as driver_tank(), Drive::arcade_standard() puts the curve buttons in arcade
+  static bool arcade_set = false;
+  if (!arcade_set) {
+    chassis.arcade_standard(stick_type);
+    arcade_set = true;
+  }
+  chassis.reset_drive_sensors_opcontrol();
+  chassis.modify_curve_with_controller();
+
+  int fwd_stick = master.get_analog(ANALOG_LEFT_Y);
+  int turn_stick = master.get_analog(stick_type == ez::SPLIT ? ANALOG_RIGHT_X : ANALOG_LEFT_X);
+  if (position_hold(abs(fwd_stick) > chassis.JOYSTICK_THRESHOLD || abs(turn_stick) > chassis.JOYSTICK_THRESHOLD)) return;
+
+  // Arcade puts forward through the left curve and turn through the right
+  double fwd = chassis.left_curve_function(fwd_stick);
+  double turn = chassis.right_curve_function(turn_stick);
+  driver_output(fwd + turn, fwd - turn);
+}
@@ -0,0 +1,176 @@
+#include "main.h"
+#include "imu_group.hpp"
+#include <new>
+
+ImuGroup::ImuGroup(Drive &drive, std::vector<int> ports) : drive(drive), ports(ports) {
+  for (auto port : ports) {
+    imus.push_back(pros::Imu(port));
+    last.push_back(0);
+    healthy.push_back(false);
+  }
+}
+
+bool ImuGroup::read(int index, double &output) {
+  double rotation = imus[index].get_rotation();
+  // PROS_ERR_F is returned with errno ENODEV when the sensor is unplugged
+  if (rotation == PROS_ERR_F || std::isnan(rotation) || imus[index].is_calibrating())
+    return false;
+  output = rotation;
+  return true;
+}
+
+bool ImuGroup::initialize(bool run_loading_animation) {
+  // Start every calibration before waiting on any of them, so extra IMUs cost no boot time
+  for (auto &imu : imus) {
+    imu.reset();
+  }
+
+  int iter = 0;
+  while (iter < 3000) {
+    bool calibrating = false;
+    for (auto &imu : imus) {
+      if (imu.is_calibrating()) calibrating = true;
+    }
+    if (!calibrating) break;
+
+    if (run_loading_animation) drive.imu_loading_display(iter);
+    iter += util::DELAY_TIME;
+    pros::delay(util::DELAY_TIME);
+  }
+
+  reset(0);
+  if (healthy_count() == 0) {
+    master.rumble("---");
+    printf("No IMU plugged in, (took %d ms to realize that)\n", iter);
+    return false;
+  }
+  printf("%d of %d IMUs calibrated in %d ms\n", healthy_count(), (int)imus.size(), iter);
+
+  if (!healthy[drive_index]) {
+    for (int i = 0; i < (int)imus.size(); i++) {
+      if (healthy[i]) {
+        rebind_drive(i);
+        break;
+      }
+    }
+  }
+
+  if (!running) {
+    running = true;
+    pros::Task imu_fusion([this] { this->imu_task(); });
+  }
+  return true;
+}
+
+double ImuGroup::get_rotation() { return fused; }
+
+void ImuGroup::reset(double new_heading) {
+  mutex.take();
+  fused = new_heading;
+  last_delta = 0;
+  for (int i = 0; i < (int)imus.size(); i++) {
+    double rotation;
+    healthy[i] = read(i, rotation);
+    if (healthy[i]) imus[i].set_rotation(new_heading);
+    last[i] = new_heading;
+  }
+  mutex.give();
+}
+
+void ImuGroup::set_angle(double angle) {
+  drive.headingPID.set_target(angle);
+  reset(angle);
+}
+
+bool ImuGroup::is_healthy(int index) { return healthy[index]; }
+
+int ImuGroup::healthy_count() {
+  int count = 0;
+  for (auto is_healthy : healthy) {
+    if (is_healthy) count++;
+  }
+  return count;
+}
+
+int ImuGroup::get_drive_index() { return drive_index; }
+
+void ImuGroup::set_outlier_threshold(double degrees) { outlier_threshold = fabs(degrees); }
+
+void ImuGroup::rebind_drive(int index) {
+  printf("IMU on port %d lost, drive now using port %d\n", ports[drive_index], ports[index]);
+  master.rumble("-");
+
+  // Drive::imu can't be reassigned (its port is const), so construct the new sensor in place
+  drive.imu.~Imu();
+  new (&drive.imu) pros::Imu(ports[index]);
+  drive_index = index;
+
+  drive.imu.set_rotation(fused);
+  last[index] = fused;
+}
+
+void ImuGroup::update() {
+  std::vector<double> deltas;
+  for (int i = 0; i < (int)imus.size(); i++) {
+    double rotation;
+    if (!read(i, rotation)) {
+      healthy[i] = false;
+      continue;
+    }
+    // A sensor coming back only rejoins once it has a fresh reference point
+    if (!healthy[i]) {
+      healthy[i] = true;
+      last[i] = rotation;
+      continue;
+    }
+    deltas.push_back(rotation - last[i]);
+    last[i] = rotation;
+  }
+
+  if (!deltas.empty()) {
+    std::vector<double> sorted = deltas;
+    std::sort(sorted.begin(), sorted.end());
+    double median = sorted.size() % 2 ? sorted[sorted.size() / 2] : (sorted[sorted.size() / 2 - 1] + sorted[sorted.size() / 2]) / 2.0;
+
+    std::vector<double> accepted;
+    if (deltas.size() == 2 && fabs(deltas[0] - deltas[1]) > outlier_threshold) {
+      // Two sensors that disagree can't outvote each other, trust the one that matches the last tick
+      accepted.push_back(fabs(deltas[0] - last_delta) < fabs(deltas[1] - last_delta) ? deltas[0] : deltas[1]);
+    } else {
+      for (auto delta : deltas) {
+        if (fabs(delta - median) <= outlier_threshold) accepted.push_back(delta);
+      }
+      if (accepted.empty()) accepted.push_back(median);
+    }
+
+    double sum = 0;
+    for (auto delta : accepted) sum += delta;
+    last_delta = sum / accepted.size();
+    fused += last_delta;
+  }
+
+  // Right away in any mode, headingPID and turnPID would read PROS_ERR_F until the end of the match otherwise
+  if (!healthy[drive_index]) {
+    for (int i = 0; i < (int)imus.size(); i++) {
+      if (healthy[i]) {
+        rebind_drive(i);
+        break;
+      }
+    }
+  }
+
+  // Keep the Drive's IMU reading the fused heading
+  if (healthy[drive_index] && fabs(last[drive_index] - fused) > 0.01) {
+    drive.imu.set_rotation(fused);
+    last[drive_index] = fused;
+  }
+}
+
+void ImuGroup::imu_task() {
+  while (true) {
+    mutex.take();
+    update();
+    mutex.give();
+    pros::delay(util::DELAY_TIME);
+  }
+}
@@ -0,0 +1,247 @@
+#include "main.h"
+#include "intake.hpp"
+
+IntakeController::IntakeController(pros::Motor_Group &motors, int optical_port) : optical(optical_port), motors(motors) {}
+
+void IntakeController::initialize() {
+  optical.set_led_pwm(100);
+
+  // Free speed of the cartridge, so percent speeds map to rpm
+  std::vector<pros::motor_gearset_e_t> gearing = motors.get_gearing();
+  if (!gearing.empty()) {
+    if (gearing[0] == pros::E_MOTOR_GEARSET_06) max_rpm = 600;
+    if (gearing[0] == pros::E_MOTOR_GEARSET_18) max_rpm = 200;
+    if (gearing[0] == pros::E_MOTOR_GEARSET_36) max_rpm = 100;
+  }
+
+  pros::Task intake_control([this] { this->intake_task(); });
+}
+
+void IntakeController::intake(int p_speed) {
+  speed = abs(p_speed);
+  seen_timer = 0;
+  intake_timer = 0;
+  state = INTAKE_INTAKING;
+}
+
+void IntakeController::outtake(int p_speed) {
+  speed = abs(p_speed);
+  clear_timer = 0;
+  state = INTAKE_OUTTAKING;
+}
+
+void IntakeController::stop() { move(0); }
+
+void IntakeController::move(int p_speed) {
+  manual_voltage = p_speed * 120;
+  state = INTAKE_IDLE;
+  if (unjam_timer <= 0) motors.move_voltage(voltageComp.compensate(manual_voltage, 12000));
+}
+
+void IntakeController::set_stall_detection(double current, double velocity, int time, int unjam) {
+  stall_current = util::clip_num(current, 1, 0);
+  stall_velocity = fabs(velocity);
+  stall_time = abs(time);
+  unjam_time = abs(unjam);
+}
+
+int IntakeController::get_jam_count() { return jam_count; }
+
+int IntakeController::get_time_lost() { return time_lost; }
+
+intake_state IntakeController::get_state() { return state; }
+
+bool IntakeController::has_triball() {
+  int32_t proximity = optical.get_proximity();
+  if (proximity == PROS_ERR || proximity < detect_proximity) return false;
+  double hue = optical.get_hue();
+  if (hue_min <= hue_max) return hue >= hue_min && hue <= hue_max;
+  return hue >= hue_min || hue <= hue_max;
+}
+
+void IntakeController::set_detection(int proximity, double p_hue_min, double p_hue_max) {
+  detect_proximity = proximity;
+  hue_min = p_hue_min;
+  hue_max = p_hue_max;
+}
+
+void IntakeController::signal() {
+  if (waiter) pros::c::task_notify(waiter);
+}
+
+bool IntakeController::wait_for(intake_state done, int timeout) {
+  pros::c::task_notify_take(true, 0);
+  waiter = pros::c::task_get_current();
+  bool finished = state == done;
+  if (!finished) {
+    pros::c::task_notify_take(true, timeout);
+    finished = state == done;
+  }
+  waiter = nullptr;
+  return finished;
+}
+
+bool IntakeController::wait_until_held(int timeout) { return wait_for(INTAKE_HOLDING, timeout); }
+
+bool IntakeController::wait_until_empty(int timeout) { return wait_for(INTAKE_IDLE, timeout); }
+
+void IntakeController::set_velocity_control(bool toggle) { velocity_control = toggle; }
+
+void IntakeController::set_top_speed(double fraction) { top_speed = util::clip_num(fraction, 1, 0.1); }
+
+void IntakeController::set_velocity_constants(double p_kv, double kp, double ki, double start_i) {
+  kv = p_kv;
+  velocity_pid.set_constants(kp, ki, 0, start_i);
+}
+
+double IntakeController::get_target_rpm() { return target_rpm; }
+
+double IntakeController::get_actual_rpm() {
+  std::vector<double> velocities = motors.get_actual_velocities();
+  double velocity = 0;
+  int count = 0;
+  for (auto v : velocities) {
+    if (v == PROS_ERR_F) continue;
+    velocity += v;
+    count++;
+  }
+  return count == 0 ? 0 : velocity / count;
+}
+
+double IntakeController::get_tracking_ratio() { return requested_sum == 0 ? 0 : achieved_sum / requested_sum; }
+
+int IntakeController::get_triball_count() { return triball_count; }
+
+double IntakeController::get_average_intake_time() { return triball_count == 0 ? 0 : intake_time_sum / (double)triball_count; }
+
+bool IntakeController::is_stalled() {
+  std::vector<std::int32_t> currents = motors.get_current_draws();
+  std::vector<double> velocities = motors.get_actual_velocities();
+  std::vector<double> efficiencies = motors.get_efficiencies();
+  std::vector<std::int32_t> limits = motors.get_current_limits();
+  if (currents.empty() || limits.size() != currents.size()) return false;
+
+  // Compared to the limit the motors actually have, the current arbiter can lower it
+  double current = 0, limit = 0, velocity = 0, efficiency = 0;
+  for (int i = 0; i < (int)currents.size(); i++) {
+    if (currents[i] == PROS_ERR || limits[i] == PROS_ERR || velocities[i] == PROS_ERR_F || efficiencies[i] == PROS_ERR_F) return false;
+    current += currents[i];
+    limit += limits[i];
+    velocity += fabs(velocities[i]);
+    efficiency += efficiencies[i];
+  }
+  current /= currents.size();
+  limit /= currents.size();
+  velocity /= currents.size();
+  efficiency /= currents.size();
+  return current > limit * stall_current && velocity < stall_velocity && efficiency < 10;
+}
+
+void IntakeController::update() {
+  bool seen = has_triball();
+  int command = 0;
+  switch (state) {
+    case INTAKE_IDLE:
+      // Runs whatever setIntake() asked for
+      command = manual_voltage;
+      break;
+
+    case INTAKE_INTAKING:
+      command = speed * 120;
+      intake_timer += util::DELAY_TIME;
+      seen_timer = seen ? seen_timer + util::DELAY_TIME : 0;
+      // Two ticks in a row so a triball bouncing past the sensor doesn't count
+      if (seen_timer >= 2 * util::DELAY_TIME) {
+        command = 0;
+        clear_timer = 0;
+        triball_count++;
+        intake_time_sum += intake_timer;
+        state = INTAKE_HOLDING;
+        signal();
+      }
+      break;
+
+    case INTAKE_HOLDING:
+      command = 0;
+      clear_timer = seen ? 0 : clear_timer + util::DELAY_TIME;
+      if (clear_timer >= 100) {
+        manual_voltage = 0;
+        state = INTAKE_IDLE;
+        signal();
+      }
+      break;
+
+    case INTAKE_OUTTAKING:
+      command = -speed * 120;
+      clear_timer = seen ? 0 : clear_timer + util::DELAY_TIME;
+      // Keep spinning a little after the sensor clears so the triball makes it out
+      if (clear_timer >= 150) {
+        command = 0;
+        manual_voltage = 0;
+        state = INTAKE_IDLE;
+        signal();
+      }
+      break;
+  }
+
+  // Unjam by reversing for a moment, then go back to what was asked for
+  if (unjam_timer > 0) {
+    motors.move_voltage(jam_command > 0 ? -12000 : 12000);
+    unjam_timer -= util::DELAY_TIME;
+    time_lost += util::DELAY_TIME;
+    if (unjam_timer <= 0) grace_timer = 200;
+    return;
+  }
+
+  // Motors draw a lot of current while they spin up, don't call that a jam
+  if (command != last_command) {
+    grace_timer = 200;
+    velocity_pid.reset_variables();
+  }
+  last_command = command;
+
+  if (velocity_control && command != 0) {
+    // Feedforward gets close to the target rpm, the PID makes up for load and battery sag.
+    // Full command asks for top_speed of free speed, free speed itself can't be held under load
+    target_rpm = command / 12000.0 * max_rpm * top_speed;
+    double actual = get_actual_rpm();
+    velocity_pid.set_target(target_rpm);
+    double output = voltageComp.compensate(target_rpm * kv, 12000) + velocity_pid.compute(actual);
+    motors.move_voltage(util::clip_num(output, 12000, -12000));
+
+    requested_sum += fabs(target_rpm);
+    achieved_sum += fabs(actual);
+  } else {
+    target_rpm = command / 12000.0 * max_rpm;
+    motors.move_voltage(voltageComp.compensate(command, 12000));
+  }
+
+  if (grace_timer > 0) {
+    grace_timer -= util::DELAY_TIME;
+    stall_timer = 0;
+    return;
+  }
+
+  // Holding a triball stalls the motors on purpose, reversing would spit it out
+  if (seen || state == INTAKE_HOLDING) {
+    stall_timer = 0;
+    return;
+  }
+
+  stall_timer = abs(command) > 3000 && is_stalled() ? stall_timer + util::DELAY_TIME : 0;
+  if (stall_timer >= stall_time) {
+    jam_count++;
+    time_lost += stall_timer;
+    jam_command = command;
+    unjam_timer = unjam_time;
+    stall_timer = 0;
+    printf("Intake jam %i, %i ms lost to jams\n", jam_count, time_lost);
+  }
+}
+
+void IntakeController::intake_task() {
+  while (true) {
+    update();
+    pros::delay(util::DELAY_TIME);
+  }
+}
@@ -0,0 +1,102 @@
+#include "main.h"
+#include "interference.hpp"
+
+InterferenceDetector::InterferenceDetector(Drive &drive, DriveHealth &health, ImuGroup &imus) : drive(drive), health(health), imus(imus) {}
+
+void InterferenceDetector::initialize() {
+  double tick_per_inch = drive.get_tick_per_inch();
+  left_filter.reset(health.get_left() / tick_per_inch);
+  right_filter.reset(health.get_right() / tick_per_inch);
+  heading_filter.reset(imus.get_rotation());
+  pros::Task interference_detection([this] { this->interference_task(); });
+}
+
+interference_type InterferenceDetector::get_state() { return state; }
+
+int InterferenceDetector::get_count() { return count; }
+
+void InterferenceDetector::on_interference(std::function<void(interference_type)> p_callback) { callback = p_callback; }
+
+void InterferenceDetector::set_model(double p_lag, double p_stall_fraction, double p_spin_rate) {
+  lag = fabs(p_lag);
+  stall_fraction = util::clip_num(p_stall_fraction, 1, 0);
+  spin_rate = fabs(p_spin_rate);
+}
+
+void InterferenceDetector::set_track_width(double p_track_width) { track_width = fabs(p_track_width); }
+
+interference_type InterferenceDetector::wait_for(int timeout) {
+  pros::c::task_notify_take(true, 0);
+  waiter = pros::c::task_get_current();
+  if (state == INTERFERENCE_NONE) pros::c::task_notify_take(true, timeout);
+  waiter = nullptr;
+  return state;
+}
+
+double InterferenceDetector::get_command(std::vector<pros::Motor> &motors) {
+  std::int32_t mV = motors[0].get_voltage();
+  return mV == PROS_ERR ? 0 : mV / 1000.0;
+}
+
+void InterferenceDetector::update() {
+  double dt = util::DELAY_TIME / 1000.0;
+  double tick_per_inch = drive.get_tick_per_inch();
+  left_filter.update(health.get_left() / tick_per_inch, dt);
+  right_filter.update(health.get_right() / tick_per_inch, dt);
+  heading_filter.update(imus.get_rotation(), dt);
+
+  // Every cartridge's encoder counts 3000 ticks per second at free speed
+  double free_speed = 3000.0 / tick_per_inch;
+  double left_command = get_command(drive.left_motors);
+  double right_command = get_command(drive.right_motors);
+  left_model += (left_command / 12.0 * free_speed - left_model) * dt / lag;
+  right_model += (right_command / 12.0 * free_speed - right_model) * dt / lag;
+
+  double command = (left_command + right_command) / 2.0;
+  double model = (left_model + right_model) / 2.0;
+  double model_turn_rate = (left_model - right_model) / track_width * 180.0 / M_PI;
+  double velocity = (left_filter.velocity + right_filter.velocity) / 2.0;
+  double turn_rate = heading_filter.velocity;
+
+  // Only judge the drive when it's being asked to do something, and the model
+  // says it should be moving by now, so a reversal isn't mistaken for a push
+  bool driving = fabs(command) > 3;
+  bool expected = fabs(model) > 5;
+  bool stalled = driving && expected && fabs(velocity) < fabs(model) * stall_fraction;
+  bool pushed = driving && expected && velocity * util::sgn(model) < -3;
+  // A turn lagging the model is normal, spun is turning when the model isn't, or the opposite way to it
+  bool turning = fabs(model_turn_rate) > spin_rate / 2.0;
+  double tolerance = fmax(spin_rate / 2.0, fabs(model_turn_rate) * stall_fraction);
+  bool spun = turning ? turn_rate * util::sgn(model_turn_rate) < -tolerance : fabs(turn_rate) > spin_rate;
+
+  stall_timer = stalled ? stall_timer + util::DELAY_TIME : 0;
+  push_timer = pushed ? push_timer + util::DELAY_TIME : 0;
+  spin_timer = spun ? spin_timer + util::DELAY_TIME : 0;
+
+  // Pushed back and spun say more than stalled, so they win
+  interference_type detected = INTERFERENCE_NONE;
+  if (stall_timer >= 100) detected = INTERFERENCE_STALLED;
+  if (push_timer >= 100) detected = INTERFERENCE_PUSHED_BACK;
+  if (spin_timer >= 100) detected = INTERFERENCE_SPUN;
+
+  if (detected != INTERFERENCE_NONE) {
+    clear_timer = 0;
+    if (detected != state) {
+      state = detected;
+      count++;
+      printf("Interference, %s\n", detected == INTERFERENCE_STALLED ? "stalled" : detected == INTERFERENCE_PUSHED_BACK ? "pushed back" : "spun");
+      if (waiter) pros::c::task_notify(waiter);
+      if (callback) callback(state);
+    }
+  } else if (state != INTERFERENCE_NONE) {
+    clear_timer += util::DELAY_TIME;
+    if (clear_timer >= 100) state = INTERFERENCE_NONE;
+  }
+}
+
+void InterferenceDetector::interference_task() {
+  while (true) {
+    update();
+    pros::delay(util::DELAY_TIME);
+  }
+}
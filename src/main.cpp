@@ -52,6 +52,45 @@ Drive chassis (
   // ,1
 );
 
+// IMU group
+//   the first port must be the IMU port above, add more ports for backup IMUs!
+ImuGroup imus(chassis, {16, 17});
+
+// Reads every drive motor and moves the sensored port off a bad motor
+DriveHealth driveHealth(chassis);
+
+// Notices pinning, pushing and spinning from other robots
+InterferenceDetector interference(chassis, driveHealth, imus);
+
+// Backs off drive torque when the wheels slip
+TractionControl traction(chassis, driveHealth);
+
+// Limits acceleration toward tipping over
+AntiTip antiTip(chassis);
+
+// Odometry, tracks position from the drive encoders and IMUs
+Odometry odom(chassis, imus);
+
+// Battery compensation, (mV that motor commands are tuned at, a charged battery sits around 12800)
+VoltageCompensator voltageComp(12800);
+
+// Predicts overheating and derates before the motors throttle themselves
+ThermalMonitor thermals;
+
+// Shares the brain's current between the drive, intake and catapult, (mA budget)
+CurrentArbiter currentArbiter(20000);
+
+// Timestamped encoder and heading reads for the custom motions
+DriveSensors driveSensors(chassis, imus);
+
+// Runs driver control, (tick in ms)
+Scheduler driverScheduler(10);
+
+// Distance sensors for wall motions
+//   (port, inches from the center of turning to the sensor, true if facing backwards)
+WallSensor back_left_wall(12, 6.0, true);
+WallSensor back_right_wall(13, 6.0, true);
+
 
 
 /**
@@ -72,6 +111,7 @@ void initialize() {
   chassis.set_curve_default(0, 0); // Defaults for curve. If using tank, only the first parameter is used. (Comment this line out if you have an SD card!)  
   default_constants(); // Set the drive to your own constants from autons.cpp!
   exit_condition_defaults(); // Set the exit conditions to your own constants from autons.cpp!
+  set_control_rate(5); // Loop period in ms for push() and the wall motions, 5, 10 or 20.  Constants stay tuned at 10ms
 
   // These are already defaulted to these buttons, but you can change the left/right curve buttons here!
   // chassis.set_left_curve_buttons (pros::E_CONTROLLER_DIGITAL_LEFT, pros::E_CONTROLLER_DIGITAL_RIGHT); // If using tank, only the left side is used. 
@@ -87,7 +127,51 @@ void initialize() {
   });
 
   // Initialize chassis and auton selector
-  chassis.initialize();
+  chassis.init_curve_sd();
+  voltageComp.initialize(); // Scales motor commands by battery voltage
+  imus.initialize(); // Calibrates every IMU at once, use this instead of chassis.initialize()
+  // odom.set_gps(19, 0, 0); // Uncomment if using a GPS, offsets are meters from the center of turning
+  // odom.set_gps_data_rate(20); // Time between GPS readings in ms
+  driveHealth.initialize();
+  interference.initialize();
+  odom.initialize();
+  // traction.set_forward_axis('x'); // Uncomment if the IMU's x axis points forward instead of y
+  traction.initialize(); // Start flat!
+  antiTip.initialize(); // Start flat!
+  intakeController.initialize();
+  intakeController.set_velocity_control(true); // Holds intake rpm under load and battery sag
+  intakeController.set_top_speed(0.85); // Full command asks for 85% of free speed, what the intake can actually hold loaded
+  catapultController.initialize(); // Start with the catapult just fired!
+  catapultController.set_load_sensor(7); // Distance sensor that sees a triball on the catapult
+  pneumatics_initialize(); // Runs timed pistons in the background
+
+  // Motor groups to watch for overheating, (name on the controller, motors, what to do as they heat up)
+  std::vector<pros::Motor> drive_motors = chassis.left_motors;
+  for (auto motor : chassis.right_motors) drive_motors.push_back(motor);
+  thermals.add_group("Drv", drive_motors, [](double derate) { currentArbiter.set_scale("drive", derate, "thermal"); });
+  thermals.add_group("Cat", {catapult}, [](double derate) { catapultController.set_duty_cycle(derate); });
+  thermals.initialize();
+
+  // Current budget, (name, motors, mA each motor always gets, priority, how to set the limit, when it needs current)
+  currentArbiter.add("drive", drive_motors.size(), 1500, 3, [](int mA) { chassis.set_drive_current_limit(mA); });
+  currentArbiter.add("catapult", 1, 500, 2, [](int mA) { catapult.set_current_limit(mA); }, [] { return catapultController.is_running(); });
+  currentArbiter.add("intake", 2, 500, 1, [](int mA) {
+    Intake1.set_current_limit(mA);
+    Intake2.set_current_limit(mA);
+  }, [] { return intakeController.get_target_rpm() != 0; });
+  currentArbiter.initialize();
+
+  // Driver control jobs, (name, function, period in ms, priority)
+  set_driver_acceleration(8, 15, 2); // (speeding up, slowing down, jerk) out of 127 every 10ms, all 0 turns it off
+  set_heading_assist(true, 8); // Holds heading with headingPID while both sticks are within 8 of each other
+  driverScheduler.add("drive", driver_tank, ez::util::DELAY_TIME, 3); // Tank control with acceleration limiting, heading assist and anti-tip.  Keep the drive at ez::util::DELAY_TIME, the joystick curve and active brake are tuned for it
+  // driverScheduler.add("drive", [] { driver_arcade(ez::SPLIT); }, ez::util::DELAY_TIME, 3); // Standard split arcade, with the same limiting and anti-tip
+  driverScheduler.add("intake", intakeControl, 10, 2);
+  driverScheduler.add("slapper", slapperControl, 10, 2);
+  driverScheduler.add("wings", wingTeleControl, 20, 1);
+  driverScheduler.add("blocker", blockerTeleControl, 20, 1);
+  driverScheduler.add("chomper", chomperTelecontrol, 20, 1);
+  driverScheduler.add("back wings", BwingTeleControl, 20, 1);
   ez::as::initialize();
   pros::lcd::set_background_color(128, 0, 0);
   pros::lcd::set_text_color(255, 255, 255);
@@ -101,7 +185,15 @@ void initialize() {
  * the robot is enabled, this task will exit.
  */
 void disabled() {
-  // . . .
+  catapultController.print_report(); // Shot count and cycle times from the last run
+  driverScheduler.print_report(); // How long each driver control job took
+  driveSensors.print_report(); // How often the last motion read a stale encoder sample
+  voltageComp.print_report(); // Battery voltage and compensation gain
+  thermals.print_report(); // Motor temperatures and time until they throttle
+  currentArbiter.print_report(); // Where the current budget went
+  driveHealth.print_report(); // Faulted drive motors
+  traction.print_report(); // Wheel slip
+  driver_print_report(); // Peak drive current in driver control
 }
 
 
@@ -134,8 +226,10 @@ void competition_initialize() {
  */
 void autonomous() {
   chassis.reset_pid_targets(); // Resets PID targets to 0
-  chassis.reset_gyro(); // Reset gyro position to 0
+  imus.reset(); // Reset gyro position to 0 on every IMU
   chassis.reset_drive_sensor(); // Reset drive sensors to 0
+  driveHealth.tare(); // Reset the other drive motors too, so any of them can take over as the sensored motor
+  odom.set_pose(0, 0, 0); // Reset tracked position, autons with a GPS can use odom.set_pose_from_gps()
   chassis.set_drive_brake(MOTOR_BRAKE_HOLD); // Set motors to hold.  This helps autonomous consistency.
 
   ez::as::auton_selector.call_selected_auton(); // Calls selected auton from autonomous selector.
@@ -160,24 +254,6 @@ void opcontrol() {
   // This is preference to what you like to drive on.
   chassis.set_drive_brake(MOTOR_BRAKE_COAST);
 
-  while (true) {
-
-    chassis.tank(); // Tank control
-    intakeControl();
-    slapperControl();
-    wingTeleControl();
-    blockerTeleControl();
-    chomperTelecontrol();
-    BwingTeleControl();
-    // chassis.arcade_standard(ez::SPLIT); // Standard split arcade
-    // chassis.arcade_standard(ez::SINGLE); // Standard single arcade
-    // chassis.arcade_flipped(ez::SPLIT); // Flipped split arcade
-    // chassis.arcade_flipped(ez::SINGLE); // Flipped single arcade
-
-    // . . .
-    // Put more user control code here!
-    // . . .
-
-    pros::delay(ez::util::DELAY_TIME); // This is used for timer calculations!  Keep this ez::util::DELAY_TIME
-  }
+  // Jobs are added in initialize(), this never returns
+  driverScheduler.run();
 }
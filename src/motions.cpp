@@ -0,0 +1,185 @@
+#include "main.h"
+#include "motions.hpp"
+
+WallSensor::WallSensor(int port, double offset, bool backwards) : sensor(port), offset(offset), backwards(backwards) {}
+
+bool WallSensor::get(double &inches) {
+  int32_t mm = sensor.get();
+  // 9999 is returned when nothing is in range
+  if (mm == PROS_ERR || mm <= 0 || mm >= 9999) return false;
+  inches = mm / 25.4;
+  return true;
+}
+
+// Moves the tracked position so the sensor reading lines up with the wall
+static void relocalize(WallSensor &sensor, double reading, const field_wall *wall) {
+  if (!wall) return;
+  pose current = odom.get_pose();
+  double facing = (current.theta + (sensor.backwards ? 180 : 0)) * M_PI / 180.0;
+  double reach = reading + sensor.offset;
+  if (wall->is_x)
+    odom.set_x(wall->position - reach * sin(facing));
+  else
+    odom.set_y(wall->position - reach * cos(facing));
+}
+
+bool drive_to_wall(WallSensor &sensor, double target, int speed, const field_wall *wall) {
+  // Drive constants are tuned in ticks, the sensor reads inches
+  double tick_per_inch = chassis.get_tick_per_inch();
+  PID::Constants drive = chassis.forward_drivePID.get_constants();
+  PID::Constants heading = chassis.headingPID.get_constants();
+  RatePID wall_pid(drive.kp * tick_per_inch, drive.ki * tick_per_inch, drive.kd * tick_per_inch, drive.start_i / tick_per_inch, "Wall");
+  RatePID heading_pid(heading.kp, heading.ki, heading.kd, heading.start_i);
+  wall_pid.set_exit_condition(30, 0.5, 150, 1.5, 200, 500);
+  wall_pid.set_target(target);
+  heading_pid.set_target(imus.get_rotation());
+
+  int dt = get_control_rate();
+  chassis.set_mode(ez::DISABLE);
+  driveSensors.reset();
+  double reading = target;
+  int lost_timer = 0;
+  while (true) {
+    driveSensors.update();
+    if (!sensor.get(reading)) {
+      lost_timer += dt;
+      if (lost_timer >= 100) {
+        chassis.set_tank(0, 0);
+        return false;
+      }
+      pros::delay(dt);
+      continue;
+    }
+    lost_timer = 0;
+
+    // The reading shrinks as a front sensor drives forward, and as a back sensor drives backward
+    double output = wall_pid.compute(reading);
+    double drive_out = util::clip_num(sensor.backwards ? output : -output, speed, -speed);
+    double gyro_out = heading_pid.compute(driveSensors.get_heading(), driveSensors.get_heading_rate() * util::DELAY_TIME / 1000.0);
+    compensated_tank(drive_out + gyro_out, drive_out - gyro_out);
+
+    if (wall_pid.exit_condition(chassis.left_motors) != ez::RUNNING) break;
+    pros::delay(dt);
+  }
+  chassis.set_tank(0, 0);
+
+  relocalize(sensor, reading, wall);
+  return true;
+}
+
+bool square_to_wall(WallSensor &left, WallSensor &right, double spacing, int speed, const field_wall *wall) {
+  PID::Constants turn = chassis.turnPID.get_constants();
+  RatePID square_pid(turn.kp, turn.ki, turn.kd, turn.start_i, "Square");
+  square_pid.set_exit_condition(50, 1, 250, 3, 250, 500);
+  square_pid.set_target(0);
+
+  int dt = get_control_rate();
+  chassis.set_mode(ez::DISABLE);
+  double left_reading = 0, right_reading = 0;
+  int lost_timer = 0;
+  while (true) {
+    if (!left.get(left_reading) || !right.get(right_reading)) {
+      lost_timer += dt;
+      if (lost_timer >= 100) {
+        chassis.set_tank(0, 0);
+        return false;
+      }
+      pros::delay(dt);
+      continue;
+    }
+    lost_timer = 0;
+
+    // Degrees the robot is turned clockwise past square
+    double difference = left.backwards ? left_reading - right_reading : right_reading - left_reading;
+    double angle = atan2(difference, spacing) * 180.0 / M_PI;
+
+    double output = util::clip_num(square_pid.compute(angle), speed, -speed);
+    compensated_tank(output, -output);
+
+    if (square_pid.exit_condition(chassis.left_motors) != ez::RUNNING) break;
+    pros::delay(dt);
+  }
+  chassis.set_tank(0, 0);
+
+  if (wall) {
+    odom.set_heading(wall->heading - (left.backwards ? 180 : 0));
+    relocalize(left, (left_reading + right_reading) / 2.0, wall);
+  }
+  return true;
+}
+
+// Push contact thresholds
+static double push_accel = 0.6;
+static double push_velocity_drop = 0.3;
+static int push_mA = 1800;
+static bool push_contact = false;
+
+void set_push_thresholds(double accel, double velocity_drop, int mA) {
+  push_accel = fabs(accel);
+  push_velocity_drop = util::clip_num(velocity_drop, 1, 0);
+  push_mA = abs(mA);
+}
+
+bool push_made_contact() { return push_contact; }
+
+double push(double target, int speed) {
+  double tick_per_inch = chassis.get_tick_per_inch();
+  PID::Constants drive = target < 0 ? chassis.backward_drivePID.get_constants() : chassis.forward_drivePID.get_constants();
+  PID::Constants heading = chassis.headingPID.get_constants();
+  RatePID push_pid(drive.kp * tick_per_inch, drive.ki * tick_per_inch, drive.kd * tick_per_inch, drive.start_i / tick_per_inch, "Push");
+  RatePID heading_pid(heading.kp, heading.ki, heading.kd, heading.start_i);
+  push_pid.set_exit_condition(30, 1, 150, 3, 200, 500);
+  push_pid.set_target(target);
+  heading_pid.set_target(chassis.headingPID.get_target());
+
+  int dt = get_control_rate();
+  chassis.set_mode(ez::DISABLE);
+  driveSensors.reset();
+  currentArbiter.set_focus("drive");
+  double travelled = 0;
+  // Every cartridge's encoder counts 3000 ticks per second at free speed
+  double free_speed = 3000.0 / tick_per_inch;
+  double expected = 0;
+  double last_out = 0;
+  int timer = 0;
+  int spike_time = -1000;
+  push_contact = false;
+  while (true) {
+    // Rates are per ez::util::DELAY_TIME to match the tuned kd
+    driveSensors.update();
+    travelled = driveSensors.get_distance();
+    double drive_out = util::clip_num(push_pid.compute(travelled, driveSensors.get_velocity() * util::DELAY_TIME / 1000.0), speed, -speed);
+    double gyro_out = heading_pid.compute(driveSensors.get_heading(), driveSensors.get_heading_rate() * util::DELAY_TIME / 1000.0);
+    compensated_tank(drive_out + gyro_out, drive_out - gyro_out);
+
+    // What the command should be doing, lagged like the drive so speeding up isn't mistaken for being stopped
+    double velocity = driveSensors.get_velocity() * util::sgn(drive_out);
+    expected += (fabs(drive_out) / 127.0 * free_speed - expected) * (dt / 1000.0) / 0.15;
+
+    // Speeding up spikes the IMU too, only count spikes once the command has settled
+    timer += dt;
+    bool ramping = fabs(drive_out - last_out) > 2;
+    last_out = drive_out;
+    pros::c::imu_accel_s_t accel = chassis.imu.get_accel();
+    if (!ramping && accel.x != PROS_ERR_F && sqrt(accel.x * accel.x + accel.y * accel.y) > push_accel) spike_time = timer;
+
+    // Skip the start of the push, and the very end where the command is too small to tell anything
+    if (timer > 100 && fabs(drive_out) > 15) {
+      bool stopped = velocity < expected * push_velocity_drop;
+      bool spike = timer - spike_time <= 200;
+      bool loaded = (chassis.left_mA() + chassis.right_mA()) / 2.0 > push_mA;
+      if (stopped && (spike || loaded)) {
+        push_contact = true;
+        break;
+      }
+    }
+
+    if (push_pid.exit_condition(chassis.left_motors) != ez::RUNNING) break;
+    pros::delay(dt);
+  }
+  chassis.set_tank(0, 0);
+  currentArbiter.set_focus("");
+
+  if (push_contact) printf("Push contact after %.2f in, %i ms\n", travelled, timer);
+  return travelled;
+}
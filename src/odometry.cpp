@@ -0,0 +1,231 @@
+#include "main.h"
+#include "odometry.hpp"
+
+// Wraps an angle to -180 to 180
+static double wrap_180(double angle) {
+  while (angle > 180) angle -= 360;
+  while (angle < -180) angle += 360;
+  return angle;
+}
+
+Odometry::Odometry(Drive &drive, ImuGroup &imus) : drive(drive), imus(imus) {}
+
+void Odometry::initialize() {
+  last_left = driveHealth.get_left();
+  last_right = driveHealth.get_right();
+  set_pose(0, 0, 0);
+  pros::Task odom_tracking([this] { this->odom_task(); });
+}
+
+pose Odometry::get_pose() {
+  mutex.take();
+  pose output = current;
+  mutex.give();
+  return output;
+}
+
+void Odometry::set_pose(double x, double y, double theta) {
+  mutex.take();
+  last_rotation = imus.get_rotation();
+  heading_offset = theta - last_rotation;
+  current.x = x;
+  current.y = y;
+  current.theta = theta;
+  pending_x = pending_y = pending_theta = 0;
+  position_variance = heading_variance = 0;
+  // A pose that didn't come from the GPS isn't in the field frame, GPS readings would drag it there
+  gps_seeded = false;
+  mutex.give();
+}
+
+void Odometry::set_x(double x) {
+  mutex.take();
+  current.x = x;
+  pending_x = 0;
+  mutex.give();
+}
+
+void Odometry::set_y(double y) {
+  mutex.take();
+  current.y = y;
+  pending_y = 0;
+  mutex.give();
+}
+
+void Odometry::remove_distance(double inches) {
+  mutex.take();
+  double theta = current.theta * M_PI / 180.0;
+  current.x -= inches * sin(theta);
+  current.y -= inches * cos(theta);
+  mutex.give();
+}
+
+void Odometry::set_heading(double theta) {
+  mutex.take();
+  double rotation = theta - heading_offset;
+  imus.reset(rotation);
+  last_rotation = rotation;
+  current.theta = theta;
+  pending_theta = 0;
+  heading_variance = 0;
+  mutex.give();
+}
+
+bool Odometry::set_pose_from_gps(int timeout) {
+  if (!gps) return false;
+  pose reading;
+  double error;
+  for (int i = 0; i <= timeout; i += util::DELAY_TIME) {
+    if (read_gps(reading, error)) {
+      set_pose(reading.x, reading.y, reading.theta);
+      gps_seeded = true;
+      return true;
+    }
+    pros::delay(util::DELAY_TIME);
+  }
+  return false;
+}
+
+void Odometry::set_gps(int port, double x_offset, double y_offset) {
+  // The odometry task reads the GPS, so swap it while holding the mutex.
+  // Changing ports reuses the same sensor object instead of leaking a new one
+  mutex.take();
+  if (gps) {
+    gps->~Gps();
+    new (gps) pros::Gps(port, x_offset, y_offset);
+  } else {
+    gps = new pros::Gps(port, x_offset, y_offset);
+  }
+  mutex.give();
+  set_gps_data_rate(gps_data_rate);
+}
+
+void Odometry::set_gps_data_rate(int ms) {
+  gps_data_rate = ms < 5 ? 5 : ms;
+  if (gps) gps->set_data_rate(gps_data_rate);
+}
+
+void Odometry::set_gps_trust(double p_drift, double p_max_gps_error) {
+  drift = fabs(p_drift);
+  max_gps_error = fabs(p_max_gps_error);
+}
+
+void Odometry::set_correction_rate(double inches, double degrees) {
+  max_correction = fabs(inches);
+  max_heading_correction = fabs(degrees);
+}
+
+bool Odometry::read_gps(pose &output, double &error) {
+  pros::c::gps_status_s_t status = gps->get_status();
+  double rms = gps->get_error();
+  double heading = gps->get_heading();
+  if (status.x == PROS_ERR_F || rms == PROS_ERR_F || heading == PROS_ERR_F) return false;
+
+  // The GPS reports meters
+  error = rms * 39.3701;
+  if (error > max_gps_error) return false;
+  output.x = status.x * 39.3701;
+  output.y = status.y * 39.3701;
+  output.theta = heading;
+  return true;
+}
+
+void Odometry::fuse(pose measured, double error) {
+  mutex.take();
+  correct(measured, error);
+  mutex.give();
+}
+
+void Odometry::correct(pose measured, double error) {
+  if (error < 0.25) error = 0.25;
+
+  // Weight the reading by how uncertain each source is
+  double position_gain = position_variance / (position_variance + error * error);
+  double dx = measured.x - (current.x + pending_x);
+  double dy = measured.y - (current.y + pending_y);
+  pending_x += position_gain * dx;
+  pending_y += position_gain * dy;
+  position_variance *= 1 - position_gain;
+
+  // GPS heading gets less trustworthy as its position error grows
+  double heading_error = fmax(0.5, error * 0.5);
+  double heading_gain = heading_variance / (heading_variance + heading_error * heading_error);
+  pending_theta += heading_gain * wrap_180(measured.theta - (current.theta + pending_theta));
+  heading_variance *= 1 - heading_gain;
+
+  residual_sum += dx * dx + dy * dy;
+  gps_count++;
+}
+
+double Odometry::get_gps_residual() { return gps_count == 0 ? 0 : sqrt(residual_sum / gps_count); }
+
+int Odometry::get_gps_count() { return gps_count; }
+
+void Odometry::update() {
+  double tick_per_inch = drive.get_tick_per_inch();
+  // Every motor on each side averaged, so a bad sensored motor doesn't throw off the position
+  double left = driveHealth.get_left();
+  double right = driveHealth.get_right();
+  double rotation = imus.get_rotation();
+
+  double dl = (left - last_left) / tick_per_inch;
+  double dr = (right - last_right) / tick_per_inch;
+  double dtheta = rotation - last_rotation;
+  last_left = left;
+  last_right = right;
+  last_rotation = rotation;
+
+  // A jump this big is a glitch, not movement
+  if (fabs(dl) > 3 || fabs(dr) > 3) dl = dr = 0;
+
+  double distance = (dl + dr) / 2.0;
+  double theta = rotation + heading_offset;
+  double mid = (current.theta + theta) / 2.0 * M_PI / 180.0;
+  current.x += distance * sin(mid);
+  current.y += distance * cos(mid);
+  current.theta = theta;
+
+  position_variance += pow(drift * distance, 2);
+  heading_variance += pow(drift * dtheta, 2) + pow(drift * distance * 0.1, 2);
+
+  // Ease position corrections in
+  double step_x = util::clip_num(pending_x, max_correction, -max_correction);
+  double step_y = util::clip_num(pending_y, max_correction, -max_correction);
+  current.x += step_x;
+  current.y += step_y;
+  pending_x -= step_x;
+  pending_y -= step_y;
+
+  // Heading corrections move the IMUs, so only give them while the drive is settled
+  if (abs(drive.left_velocity()) < 2 && abs(drive.right_velocity()) < 2)
+    settle_timer += util::DELAY_TIME;
+  else
+    settle_timer = 0;
+
+  if (settle_timer >= 100 && fabs(pending_theta) > 0.05) {
+    double step = util::clip_num(pending_theta, max_heading_correction, -max_heading_correction);
+    imus.reset(rotation + step);
+    last_rotation = rotation + step;
+    current.theta += step;
+    pending_theta -= step;
+  }
+
+  if (gps && gps_seeded) {
+    gps_timer += util::DELAY_TIME;
+    if (gps_timer >= gps_data_rate) {
+      gps_timer = 0;
+      pose reading;
+      double error;
+      if (read_gps(reading, error)) correct(reading, error);
+    }
+  }
+}
+
+void Odometry::odom_task() {
+  while (true) {
+    mutex.take();
+    update();
+    mutex.give();
+    pros::delay(util::DELAY_TIME);
+  }
+}
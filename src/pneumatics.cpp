@@ -0,0 +1,114 @@
+#include "main.h"
+#include "pneumatics.hpp"
+
+// Every actuator, so one task can run all of their schedules
+static std::vector<Actuator *> &actuators() {
+  static std::vector<Actuator *> list;
+  return list;
+}
+
+// Average drive encoder position in inches
+static double drive_distance() { return (chassis.left_sensor() + chassis.right_sensor()) / 2.0 / chassis.get_tick_per_inch(); }
+
+AirSupply::AirSupply(double tank_volume, double start_pressure, double min_pressure)
+    : min_pressure(min_pressure), tank_volume(tank_volume), pressure(start_pressure), warning_pressure(min_pressure + 10) {}
+
+// Absolute pressure of the atmosphere in psi
+static const double ATMOSPHERE = 14.7;
+
+double AirSupply::pressure_after(double volume, int strokes) {
+  // Tank air expands into a cylinder that was vented to the atmosphere
+  double absolute = pressure + ATMOSPHERE;
+  for (int i = 0; i < strokes; i++) absolute = (absolute * tank_volume + ATMOSPHERE * volume) / (tank_volume + volume);
+  return absolute - ATMOSPHERE;
+}
+
+void AirSupply::use(double volume) {
+  pressure = pressure_after(volume);
+  actuation_count++;
+}
+
+double AirSupply::get_pressure() { return pressure; }
+
+int AirSupply::get_actuation_count() { return actuation_count; }
+
+void AirSupply::reset(double p_pressure) {
+  pressure = p_pressure;
+  actuation_count = 0;
+  warned = false;
+}
+
+void AirSupply::set_warning(double p_pressure) { warning_pressure = p_pressure; }
+
+void AirSupply::update() {
+  if (warned || pressure > warning_pressure) return;
+  warned = true;
+  master.rumble("..");
+  // EZ-Template redraws its curve on line 2 and thermal uses line 1, so the top line is free
+  master.print(0, 0, "Air low %3.0f psi  ", pressure);
+  printf("Air low, %.0f psi after %i actuations\n", pressure, actuation_count);
+}
+
+Actuator::Actuator(char port, bool initial, double volume) : piston(port, initial), state(initial), volume(volume) { actuators().push_back(this); }
+
+void Actuator::apply(bool p_state) {
+  if (p_state != state) {
+    count++;
+    air.use(volume);
+  }
+  state = p_state;
+  piston.set_value(state);
+}
+
+void Actuator::set(bool p_state) {
+  pending = false;
+  apply(p_state);
+}
+
+int Actuator::get_count() { return count; }
+
+bool Actuator::can_afford(int changes) { return air.pressure_after(volume, changes) >= air.min_pressure; }
+
+bool Actuator::get() { return state; }
+
+void Actuator::toggle() { set(!state); }
+
+void Actuator::schedule(bool target, int delay, double distance) {
+  pending_state = target;
+  pending_time = pros::millis() + delay;
+  pending_distance = fabs(distance);
+  start_distance = drive_distance();
+  pending = true;
+}
+
+void Actuator::pulse(int duration) {
+  set(true);
+  schedule(false, duration, 0);
+}
+
+void Actuator::deploy_after(int delay) { schedule(true, delay, 0); }
+
+void Actuator::retract_after(int delay) { schedule(false, delay, 0); }
+
+void Actuator::retract_after_distance(double inches) { schedule(false, 0, inches); }
+
+bool Actuator::is_pending() { return pending; }
+
+void Actuator::update() {
+  if (!pending) return;
+  if ((int)pros::millis() < pending_time) return;
+  if (pending_distance > 0 && fabs(drive_distance() - start_distance) < pending_distance) return;
+
+  pending = false;
+  apply(pending_state);
+}
+
+static void pneumatics_task() {
+  while (true) {
+    for (auto actuator : actuators()) actuator->update();
+    air.update();
+    pros::delay(util::DELAY_TIME);
+  }
+}
+
+void pneumatics_initialize() { pros::Task pneumatics_timer(pneumatics_task); }
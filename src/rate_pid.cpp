@@ -0,0 +1,94 @@
+#include "main.h"
+#include "rate_pid.hpp"
+
+static int control_rate = util::DELAY_TIME;
+
+void set_control_rate(int ms) {
+  if (ms != 5 && ms != 10 && ms != 20) {
+    printf("Control rate must be 5, 10 or 20 ms, keeping %i\n", control_rate);
+    return;
+  }
+  control_rate = ms;
+}
+
+int get_control_rate() { return control_rate; }
+
+RatePID::RatePID(double p, double i, double d, double start_i, std::string name) : pid(p, i, d, start_i, name), name(name) {}
+
+void RatePID::set_target(double target) {
+  pid.reset_variables();
+  pid.set_target(target);
+  prev_error = 0;
+  first = true;
+  integral = 0;
+  start_time = prev_time = exit_time = pros::millis();
+  exit_ticks = 0;
+  last_exit = ez::RUNNING;
+}
+
+void RatePID::set_exit_condition(int small_exit_time, double small_error, int big_exit_time, double big_error, int velocity_exit_time, int mA_timeout) {
+  pid.set_exit_condition(small_exit_time, small_error, big_exit_time, big_error, velocity_exit_time, mA_timeout);
+}
+
+double RatePID::step(double error) {
+  int now = pros::millis();
+  double dt = now == prev_time ? get_control_rate() : now - prev_time;
+  prev_time = now;
+  double ticks = dt / util::DELAY_TIME;
+
+  // Same windup rules as EZ-Template, but i grows with time instead of calls
+  if (pid.constants.ki != 0) {
+    if (pid.constants.start_i == 0 || fabs(error) < pid.constants.start_i) integral += error * ticks;
+    if (util::sgn(error) != util::sgn(prev_error)) integral = 0;
+  }
+  return ticks;
+}
+
+double RatePID::compute(double current) {
+  double error = pid.get_target() - current;
+  // The first call has nothing to difference against, so d starts at 0 instead of kicking
+  if (first) prev_error = error;
+  double ticks = step(error);
+  double derivative = (error - prev_error) / ticks;
+  prev_error = error;
+  first = false;
+
+  // EZ-Template's velocity exit reads derivative, it has to be written here since the PID never computes
+  pid.error = error;
+  pid.cur = current;
+  pid.prev_error = prev_error;
+  pid.derivative = derivative;
+  pid.output = pid.constants.kp * error + pid.constants.ki * integral + pid.constants.kd * derivative;
+  return pid.output;
+}
+
+double RatePID::compute(double current, double rate) {
+  double error = pid.get_target() - current;
+  if (first) prev_error = error;
+  step(error);
+  prev_error = error;
+  first = false;
+
+  pid.error = error;
+  pid.cur = current;
+  pid.prev_error = prev_error;
+  pid.derivative = -rate;
+  pid.output = pid.constants.kp * error + pid.constants.ki * integral - pid.constants.kd * rate;
+  return pid.output;
+}
+
+ez::exit_output RatePID::exit_condition(std::vector<pros::Motor> sensor) {
+  // EZ-Template's exit timers add ez::util::DELAY_TIME every call, so call once per DELAY_TIME passed
+  int now = pros::millis();
+  exit_ticks += now - exit_time;
+  exit_time = now;
+  while (last_exit == ez::RUNNING && exit_ticks >= util::DELAY_TIME) {
+    last_exit = pid.exit_condition(sensor);
+    exit_ticks -= util::DELAY_TIME;
+  }
+
+  if (last_exit != ez::RUNNING && name != "") printf("%s settled in %i ms at %i ms\n", name.c_str(), get_elapsed(), get_control_rate());
+  return last_exit;
+}
+
+int RatePID::get_elapsed() { return pros::millis() - start_time; }
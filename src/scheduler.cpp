@@ -0,0 +1,93 @@
+#include "main.h"
+#include "scheduler.hpp"
+
+Scheduler::Scheduler(int tick) : tick(tick) {}
+
+void Scheduler::add(std::string name, std::function<void()> function, int period, int priority) {
+  job added;
+  added.name = name;
+  added.function = function;
+  added.period = period < tick ? tick : period;
+  added.priority = priority;
+
+  // Keep jobs sorted by priority so each tick runs them in order
+  auto it = jobs.begin();
+  while (it != jobs.end() && it->priority >= priority) it++;
+  jobs.insert(it, added);
+  due.reserve(jobs.size());
+}
+
+void Scheduler::set_budget(double fraction) { budget = util::clip_num(fraction, 1, 0); }
+
+void Scheduler::reset_stats() {
+  overruns = 0;
+  for (auto &j : jobs) {
+    j.runs = 0;
+    j.deferred = 0;
+    j.total_us = 0;
+    j.worst_us = 0;
+  }
+}
+
+void Scheduler::run() {
+  int start = pros::millis();
+  for (auto &j : jobs) j.next_run = start;
+  std::uint32_t now = start;
+
+  while (true) {
+    uint64_t tick_start = pros::micros();
+    uint64_t budget_us = tick * 1000 * budget;
+    int time = pros::millis();
+    bool over = false;
+
+    // Highest priority first, within a priority the jobs pushed back by an overrun go first, the most overdue first
+    due.clear();
+    for (auto &j : jobs) {
+      if (time >= j.next_run) due.push_back(&j);
+    }
+    std::stable_sort(due.begin(), due.end(), [](job *a, job *b) {
+      if (a->priority != b->priority) return a->priority > b->priority;
+      return a->waiting != b->waiting ? a->waiting : a->waiting && a->next_run < b->next_run;
+    });
+
+    for (auto jp : due) {
+      job &j = *jp;
+
+      // Out of time this tick, this job goes first next tick instead
+      if (over) {
+        j.deferred++;
+        j.waiting = true;
+        continue;
+      }
+      j.waiting = false;
+
+      uint64_t job_start = pros::micros();
+      j.function();
+      uint64_t elapsed = pros::micros() - job_start;
+
+      j.runs++;
+      j.total_us += elapsed;
+      if (elapsed > j.worst_us) j.worst_us = elapsed;
+
+      // Keep the same phase unless the job fell a whole period behind
+      j.next_run += j.period;
+      if (j.next_run <= time) j.next_run = time + j.period;
+
+      if (pros::micros() - tick_start > budget_us) {
+        over = true;
+        overruns++;
+      }
+    }
+
+    pros::Task::delay_until(&now, tick);
+  }
+}
+
+void Scheduler::print_report() {
+  printf("\nScheduler, %i ms tick, %i overruns\n", tick, overruns);
+  printf("%-12s %6s %6s %8s %8s %8s\n", "job", "period", "runs", "avg us", "worst us", "waited");
+  for (auto &j : jobs) {
+    double average = j.runs == 0 ? 0 : j.total_us / (double)j.runs;
+    printf("%-12s %6i %6i %8.0f %8i %8i\n", j.name.c_str(), j.period, j.runs, average, (int)j.worst_us, j.deferred);
+  }
+}
@@ -11,49 +11,63 @@ pros::Motor Intake1(8, pros::E_MOTOR_GEARSET_18, true,
 pros::Motor Intake2(3, pros::E_MOTOR_GEARSET_18, false,
                    pros::E_MOTOR_ENCODER_DEGREES);    
 
-pros::ADIDigitalOut wingActuation('B');
-pros::ADIDigitalOut blockerActuation('D');
-pros::ADIDigitalOut chomperactuation('E');
-pros::ADIDigitalOut BwingActuation('A');
+// (mL of every tank, psi pumped to, psi where pistons stop working)
+AirSupply air(400, 100, 40);
+
+// mL of one cylinder plus its tubing
+const double CYLINDER_VOLUME = 4.0;
+
+Actuator wingActuation('B', false, 2 * CYLINDER_VOLUME);
+Actuator blockerActuation('D', false, CYLINDER_VOLUME);
+Actuator chomperactuation('E', false, CYLINDER_VOLUME);
+Actuator BwingActuation('A', false, 2 * CYLINDER_VOLUME);
 
 pros::Motor_Group Intake({Intake1, Intake2});
 
+IntakeController intakeController(Intake, 6);
+
+// (motor, motor degrees per shot, motor degrees after a shot where it is loaded)
+CatapultController catapultController(catapult, 360, 300);
+
 bool climberLock = false;
 bool blockerState = false;
 bool bWingState = false;
 int Rumblecount = 0;
 bool drivermatchloading = false;
 
-void setIntake(int speed) { Intake.move_voltage(speed * 120); }
+void setIntake(int speed) { intakeController.move(speed); }
 
-void wingControl(bool state) { wingActuation.set_value(state); }
+void wingControl(bool state) { wingActuation.set(state); }
 
-void BwingControl(bool state){ BwingActuation.set_value(state); }
+void BwingControl(bool state){ BwingActuation.set(state); }
 
-void blockerControl(bool state) { blockerActuation.set_value(state); }
+void blockerControl(bool state) { blockerActuation.set(state); }
 
-void matchLoad(bool matchLoading, bool skills) {
+void matchLoad(bool matchLoading) {
   if (matchLoading == true) {
-    catapult.move_voltage(12500);
-    if(skills == true){
-      catapult.move_voltage(12500);
-    }
+    // Fires each triball as it's loaded until toggled off, or continuously without a load sensor
+    catapultController.match_load(0);
   } else {
-    catapult.move_voltage(0);
+    catapultController.stop();
   }
 }
 
 void slapperControl() {
   if (master.get_digital_new_press(pros::E_CONTROLLER_DIGITAL_DOWN  )) {
     drivermatchloading = !drivermatchloading;
-    matchLoad(drivermatchloading, false);
+    matchLoad(drivermatchloading);
   }
 }
 
 void intakeControl() {
-  setIntake((master.get_digital(pros::E_CONTROLLER_DIGITAL_R1) -
-             master.get_digital(pros::E_CONTROLLER_DIGITAL_R2)) *
-            100);
+  if (master.get_digital(pros::E_CONTROLLER_DIGITAL_R1)) {
+    // Intakes until a triball is seated, then holds it
+    if (intakeController.get_state() == INTAKE_IDLE) intakeController.intake();
+  } else if (master.get_digital(pros::E_CONTROLLER_DIGITAL_R2)) {
+    setIntake(-100);
+  } else if (intakeController.get_state() != INTAKE_HOLDING) {
+    setIntake(0);
+  }
 }
 
 void wingTeleControl() {
@@ -69,12 +83,12 @@ void blockerTeleControl(){
     blockerState = !blockerState;
   }
 
-  blockerActuation.set_value(blockerState);
+  blockerActuation.set(blockerState);
 }
 
 void chomperTelecontrol(){
   if(master.get_digital_new_press(pros::E_CONTROLLER_DIGITAL_B)){
-      chomperactuation.set_value(true);
+      chomperactuation.set(true);
 
   }
 }
\ No newline at end of file
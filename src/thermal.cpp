@@ -0,0 +1,128 @@
+#include "main.h"
+#include "thermal.hpp"
+
+ThermalMonitor::ThermalMonitor() {}
+
+void ThermalMonitor::add_group(std::string name, std::vector<pros::Motor> devices, std::function<void(double)> derate) {
+  group added;
+  added.name = name;
+  added.derate = derate;
+  for (auto device : devices) added.motors.push_back({device});
+  groups.push_back(added);
+}
+
+void ThermalMonitor::initialize() {
+  pros::Task thermal_control([this] { this->thermal_task(); });
+}
+
+ThermalMonitor::group *ThermalMonitor::find(std::string name) {
+  for (auto &g : groups)
+    if (g.name == name) return &g;
+  return nullptr;
+}
+
+double ThermalMonitor::get_time_to_throttle(std::string name) {
+  group *g = find(name);
+  return g ? g->time_to_throttle : -1;
+}
+
+double ThermalMonitor::get_derate(std::string name) {
+  group *g = find(name);
+  return g ? g->factor : 1;
+}
+
+void ThermalMonitor::set_derating(double p_horizon, double p_min_derate) {
+  horizon = fabs(p_horizon);
+  min_derate = util::clip_num(p_min_derate, 1, 0);
+}
+
+void ThermalMonitor::set_model(double p_heat, double p_cool) {
+  heat = fabs(p_heat);
+  cool = fabs(p_cool);
+}
+
+void ThermalMonitor::update_motor(motor &m, double dt) {
+  double sensor = m.device.get_temperature();
+  std::int32_t mA = m.device.get_current_draw();
+  if (sensor == PROS_ERR_F || mA == PROS_ERR) return;
+
+  // Starting temperature is what it cools back toward
+  if (m.ambient == 0) m.ambient = m.temperature = sensor;
+
+  // Average current squared over a few seconds, that's what heats the motor
+  double amps = mA / 1000.0;
+  m.current_squared += (amps * amps - m.current_squared) * dt / 3.0;
+
+  double rate = heat * m.current_squared - cool * (m.temperature - m.ambient);
+  m.temperature += rate * dt;
+
+  // The sensor reads in 5C steps, keep the model inside the step it reads
+  m.temperature = util::clip_num(m.temperature, sensor + 5, sensor);
+
+  if (m.temperature >= THROTTLE_TEMPERATURE)
+    m.time_to_throttle = 0;
+  else
+    m.time_to_throttle = rate > 0.001 ? (THROTTLE_TEMPERATURE - m.temperature) / rate : -1;
+
+  m.throttled = m.device.is_over_temp() == 1;
+}
+
+void ThermalMonitor::update() {
+  double dt = 0.1;
+  for (auto &g : groups) {
+    g.time_to_throttle = -1;
+    bool throttled = false;
+    for (auto &m : g.motors) {
+      bool was_throttled = m.throttled;
+      update_motor(m, dt);
+      if (m.throttled && !was_throttled) g.throttle_count++;
+      throttled = throttled || m.throttled;
+      if (m.time_to_throttle >= 0 && (g.time_to_throttle < 0 || m.time_to_throttle < g.time_to_throttle)) g.time_to_throttle = m.time_to_throttle;
+    }
+
+    // Slide from full power at the horizon to min_derate at the throttle point
+    double factor = 1;
+    if (throttled)
+      factor = min_derate;
+    else if (g.time_to_throttle >= 0 && g.time_to_throttle < horizon)
+      factor = min_derate + (1 - min_derate) * g.time_to_throttle / horizon;
+
+    if (fabs(factor - g.factor) >= 0.02 || (factor == 1 && g.factor != 1)) {
+      g.factor = factor;
+      if (g.derate) g.derate(factor);
+    }
+  }
+}
+
+void ThermalMonitor::print_report() {
+  printf("\nThermals\n");
+  for (auto &g : groups) {
+    printf("%s: %.0fs to throttle, derate %.2f, throttled %i times\n", g.name.c_str(), g.time_to_throttle, g.factor, g.throttle_count);
+    for (auto &m : g.motors) printf("  port %i %.1fC\n", m.device.get_port(), m.temperature);
+  }
+}
+
+void ThermalMonitor::thermal_task() {
+  int timer = 0;
+  while (true) {
+    update();
+
+    // Controller screen only takes a print every 50ms, once a second is plenty
+    timer += 100;
+    if (timer >= 1000 && !groups.empty()) {
+      timer = 0;
+      std::string line;
+      for (auto &g : groups) {
+        char text[12];
+        if (g.time_to_throttle < 0)
+          snprintf(text, sizeof(text), "%s -- ", g.name.c_str());
+        else
+          snprintf(text, sizeof(text), "%s %.0fs ", g.name.c_str(), g.time_to_throttle > 999 ? 999 : g.time_to_throttle);
+        line += text;
+      }
+      master.print(1, 0, "%-15s", line.c_str());
+    }
+
+    pros::delay(100);
+  }
+}
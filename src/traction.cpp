@@ -0,0 +1,107 @@
+#include "main.h"
+#include "traction.hpp"
+
+TractionControl::TractionControl(Drive &drive, DriveHealth &health) : drive(drive), health(health) {}
+
+void TractionControl::initialize() {
+  double pitch = drive.imu.get_pitch();
+  double roll = drive.imu.get_roll();
+  if (pitch != PROS_ERR_F) pitch_zero = pitch;
+  if (roll != PROS_ERR_F) roll_zero = roll;
+  encoder_filter.reset((health.get_left() + health.get_right()) / 2.0 / drive.get_tick_per_inch());
+  pros::Task traction_control([this] { this->traction_task(); });
+}
+
+bool TractionControl::is_slipping() { return slipping; }
+
+int TractionControl::get_slip_count() { return slip_count; }
+
+double TractionControl::get_slip_distance() { return slip_distance; }
+
+void TractionControl::set_forward_axis(char p_axis, bool p_reversed) {
+  axis = p_axis;
+  reversed = p_reversed;
+}
+
+void TractionControl::set_slip_detection(double speed, double p_torque) {
+  slip_speed = fabs(speed);
+  slip_torque = util::clip_num(p_torque, 1, 0);
+}
+
+void TractionControl::print_report() { printf("\nTraction, %i slips, %.1f in taken out of odometry\n", slip_count, slip_distance); }
+
+void TractionControl::update() {
+  double dt = util::DELAY_TIME / 1000.0;
+  encoder_filter.update((health.get_left() + health.get_right()) / 2.0 / drive.get_tick_per_inch(), dt);
+  double encoder_velocity = encoder_filter.velocity;
+
+  // g to inches per second squared
+  pros::c::imu_accel_s_t accel = drive.imu.get_accel();
+  if (accel.x == PROS_ERR_F) {
+    imu_velocity = encoder_velocity;
+    return;
+  }
+  // Tilted, part of gravity reads as forward acceleration, so only trust the encoders until flat again
+  double pitch = drive.imu.get_pitch();
+  double roll = drive.imu.get_roll();
+  bool tilted = pitch == PROS_ERR_F || roll == PROS_ERR_F || fabs(pitch - pitch_zero) > max_tilt || fabs(roll - roll_zero) > max_tilt;
+  if (tilted || antiTip.is_tipping()) {
+    imu_velocity = encoder_velocity;
+    slip_timer = 0;
+    slipping = false;
+    return;
+  }
+
+  double forward = (axis == 'x' ? accel.x : accel.y) * (reversed ? -1 : 1) * 386.09;
+  imu_velocity += forward * dt;
+
+  // Either the wheels are spinning faster than the robot, or skidding slower
+  double difference = encoder_velocity - imu_velocity;
+  bool split = fabs(difference) > slip_speed;
+  slip_timer = split ? slip_timer + util::DELAY_TIME : 0;
+  grip_timer = split ? 0 : grip_timer + util::DELAY_TIME;
+
+  if (!slipping && slip_timer >= 30) {
+    slipping = true;
+    slip_count++;
+    slip_duration = 0;
+    event_distance = 0;
+    torque = slip_torque;
+    currentArbiter.set_scale("drive", torque, "slip");
+  } else if (slipping && (grip_timer >= 100 || slip_duration >= max_slip_time)) {
+    // Real slip doesn't last this long, the IMU velocity has drifted, so start over from the encoders
+    if (grip_timer < 100) imu_velocity = encoder_velocity;
+    slip_timer = 0;
+    slipping = false;
+  }
+
+  if (slipping) {
+    slip_duration += util::DELAY_TIME;
+
+    // The IMU is trusted for distance until the wheels grip again, up to a limit in case it's drifting
+    double slipped = difference * dt;
+    if (fabs(event_distance + slipped) > max_slip_distance) slipped = util::sgn(slipped) * fmax(0, max_slip_distance - fabs(event_distance));
+    odom.remove_distance(slipped);
+    event_distance += slipped;
+    slip_distance += fabs(slipped);
+
+    // Slower pull toward the encoders so a bump or bias in the IMU can't grow forever
+    imu_velocity += difference * 0.01;
+  } else {
+    // Gripping, so the encoders are right and the IMU's drift gets pulled out
+    imu_velocity += difference * 0.05;
+
+    // Give torque back a little at a time so the wheels don't break loose again
+    if (torque < 1) {
+      torque = torque + 0.02 > 1 ? 1 : torque + 0.02;
+      currentArbiter.set_scale("drive", torque, "slip");
+    }
+  }
+}
+
+void TractionControl::traction_task() {
+  while (true) {
+    update();
+    pros::delay(util::DELAY_TIME);
+  }
+}